@@ -0,0 +1,524 @@
+#include "../include/matrix.hpp"
+#include "../include/vector.hpp"
+#include "../include/linalg.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * EDUCATIONAL BENCHMARK SUITE
+ *
+ * This file demonstrates:
+ * 1. Measuring kernels instead of guessing: every optimization in include/
+ *    should show up here, and every regression too
+ * 2. Reporting rates that can be compared with the hardware:
+ *    - FLOP/s against the peak of the FMA units (compute-bound kernels)
+ *    - bytes/s against the memory bandwidth (memory-bound kernels)
+ * 3. Parameter sweeps: sizes from 4 (call overhead dominates) to 8192
+ *    (caches no longer help), float and double, one to all threads
+ *
+ * BENCHMARKING CONCEPTS:
+ * - Inputs are built once, outside the timed loop
+ * - benchmark::DoNotOptimize keeps results from being optimized away
+ * - Each benchmark runs long enough for a stable average; the library
+ *   decides how many iterations that takes
+ *
+ * USAGE:
+ *   ./linalg_bench --benchmark_filter=gemm
+ *   ./linalg_bench --benchmark_out=results.json --benchmark_out_format=json
+ */
+
+namespace {
+
+/**
+ * @brief Deterministic test data in [-0.5, 0.5), diagonally dominant if square
+ */
+template<typename T>
+Matrix<T> random_matrix(size_t rows, size_t cols, unsigned seed = 12345u) {
+    Matrix<T> m(rows, cols, linalg::uninitialized);
+    unsigned state = seed;
+    for (size_t i = 0; i < rows * cols; ++i) {
+        state = state * 1664525u + 1013904223u;
+        m.data()[i] = static_cast<T>(static_cast<double>(state >> 8) / 16777216.0 - 0.5);
+    }
+    if (rows == cols) {
+        for (size_t i = 0; i < rows; ++i) m(i, i) += static_cast<T>(rows);
+    }
+    return m;
+}
+
+template<typename T>
+Vector<T> random_vector(size_t n, unsigned seed = 54321u) {
+    Vector<T> v(n);
+    unsigned state = seed;
+    for (size_t i = 0; i < n; ++i) {
+        state = state * 1664525u + 1013904223u;
+        v[i] = static_cast<T>(static_cast<double>(state >> 8) / 16777216.0 - 0.5);
+    }
+    return v;
+}
+
+/**
+ * @brief 5-point Laplacian on a grid x grid mesh (n = grid², about 5n nonzeros)
+ */
+template<typename T>
+linalg::SparseMatrix<T> laplacian_2d(size_t grid) {
+    std::vector<linalg::Triplet<T>> entries;
+    entries.reserve(5 * grid * grid);
+    for (size_t r = 0; r < grid; ++r) {
+        for (size_t c = 0; c < grid; ++c) {
+            const size_t i = r * grid + c;
+            entries.push_back({i, i, T(4)});
+            if (r > 0) entries.push_back({i, i - grid, T(-1)});
+            if (r + 1 < grid) entries.push_back({i, i + grid, T(-1)});
+            if (c > 0) entries.push_back({i, i - 1, T(-1)});
+            if (c + 1 < grid) entries.push_back({i, i + 1, T(-1)});
+        }
+    }
+    return linalg::SparseMatrix<T>(grid * grid, grid * grid, entries);
+}
+
+void set_rates(benchmark::State& state, double flops, double bytes) {
+    const double iterations = static_cast<double>(state.iterations());
+    state.counters["FLOP/s"] = benchmark::Counter(flops * iterations, benchmark::Counter::kIsRate);
+    if (bytes > 0) state.SetBytesProcessed(static_cast<int64_t>(bytes * iterations));
+}
+
+// Thread counts 1, 2, 4, ... up to (and including) all hardware threads
+std::vector<int64_t> thread_counts() {
+    const int64_t hardware = std::max<int64_t>(1, std::thread::hardware_concurrency());
+    std::vector<int64_t> counts;
+    for (int64_t t = 1; t < hardware; t *= 2) counts.push_back(t);
+    counts.push_back(hardware);
+    return counts;
+}
+
+const std::vector<int64_t> matrix_sizes = {4, 16, 64, 256, 1024, 4096, 8192};
+
+void sizes_and_threads(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "threads"})->ArgsProduct({matrix_sizes, thread_counts()});
+}
+
+// O(n³) kernels: 8192 takes minutes per thread count, so stop at 4096
+void cubic_sizes_and_threads(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "threads"})->ArgsProduct({{4, 16, 64, 256, 1024, 4096}, thread_counts()});
+}
+
+void vector_lengths(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n"})->RangeMultiplier(8)->Range(4, size_t(1) << 24);
+}
+
+/**
+ * @brief Sets the pool size from the "threads" argument (index 1 by default)
+ */
+void use_threads(const benchmark::State& state, int index = 1) {
+    const size_t threads = static_cast<size_t>(state.range(index));
+    if (linalg::get_num_threads() != threads) linalg::set_num_threads(threads);
+}
+
+/**
+ * @brief Runs a serial kernel with a one-thread pool
+ *
+ * Otherwise it would inherit the pool size of whichever benchmark ran
+ * before it, and its numbers would depend on --benchmark_filter.
+ */
+void use_one_thread() {
+    if (linalg::get_num_threads() != 1) linalg::set_num_threads(1);
+}
+
+} // namespace
+
+/**
+ * BENCHMARK: C = A·B through the blocked GEMM engine (2n³ flops)
+ */
+template<typename T>
+void BM_gemm(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    const Matrix<T> A = random_matrix<T>(n, n, 1u);
+    const Matrix<T> B = random_matrix<T>(n, n, 2u);
+    Matrix<T> C(n, n);
+    for (auto _ : state) {
+        linalg::assign_product(C, A, B);
+        benchmark::DoNotOptimize(C.data());
+        benchmark::ClobberMemory();
+    }
+    set_rates(state, 2.0 * n * n * n, 3.0 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_gemm, float)->Apply(cubic_sizes_and_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_gemm, double)->Apply(cubic_sizes_and_threads)->UseRealTime();
+
+/**
+ * BENCHMARK: y = A·x (2n² flops, memory-bound: A is read once)
+ */
+template<typename T>
+void BM_gemv(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    const Matrix<T> A = random_matrix<T>(n, n, 3u);
+    const Vector<T> x = random_vector<T>(n);
+    Vector<T> y(n);
+    for (auto _ : state) {
+        linalg::gemv(T(1), A, x, T(0), y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_rates(state, 2.0 * n * n, (n * n + 2.0 * n) * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_gemv, float)->Apply(sizes_and_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_gemv, double)->Apply(sizes_and_threads)->UseRealTime();
+
+/**
+ * BENCHMARK: y = Aᵀ·x (2n² flops, an axpy per row of A)
+ */
+template<typename T>
+void BM_gemv_transposed(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    const Matrix<T> A = random_matrix<T>(n, n, 4u);
+    const Vector<T> x = random_vector<T>(n);
+    Vector<T> y(n);
+    for (auto _ : state) {
+        linalg::gemv_transposed(T(1), A, x, T(0), y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_rates(state, 2.0 * n * n, (n * n + 2.0 * n) * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_gemv_transposed, float)->Apply(sizes_and_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_gemv_transposed, double)->Apply(sizes_and_threads)->UseRealTime();
+
+/**
+ * BENCHMARK: y = A·x for a sparse CSR Laplacian (2 flops per nonzero)
+ *
+ * Bytes count the value and index of every nonzero, the row offsets, and
+ * x and y once each.
+ */
+template<typename T>
+void BM_spmv(benchmark::State& state) {
+    const size_t grid = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    const linalg::SparseMatrix<T> A = laplacian_2d<T>(grid);
+    const size_t n = A.get_rows(), nnz = A.nonzeros();
+    const Vector<T> x = random_vector<T>(n);
+    Vector<T> y(n);
+    for (auto _ : state) {
+        linalg::spmv(T(1), A, x, T(0), y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_rates(state, 2.0 * nnz,
+              nnz * (sizeof(T) + sizeof(size_t)) + (n + 1.0) * sizeof(size_t) + 2.0 * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_spmv, float)
+    ->ArgNames({"grid", "threads"})
+    ->ArgsProduct({{32, 128, 512, 1024}, thread_counts()})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_spmv, double)
+    ->ArgNames({"grid", "threads"})
+    ->ArgsProduct({{32, 128, 512, 1024}, thread_counts()})
+    ->UseRealTime();
+
+/**
+ * BENCHMARK: 50 preconditioned CG iterations on the sparse Laplacian
+ *
+ * The tolerance is zero so every solve runs all iterations; FLOP/s counts
+ * the SpMV and the five vector operations of each iteration.
+ */
+template<typename T>
+void BM_conjugate_gradient(benchmark::State& state) {
+    const size_t grid = static_cast<size_t>(state.range(0));
+    const bool ilu = state.range(1) != 0;
+    use_threads(state, 2);
+    const linalg::SparseMatrix<T> A = laplacian_2d<T>(grid);
+    const size_t n = A.get_rows();
+    const Vector<T> b = random_vector<T>(n);
+    Vector<T> x(n);
+    linalg::IterativeOptions<T> options;
+    options.tolerance = T(0);
+    options.max_iterations = 50;
+    const linalg::JacobiPreconditioner<T> jacobi(A);
+    const linalg::ILU0Preconditioner<T> factors(A);
+    linalg::KrylovWorkspace<T> ws;
+    for (auto _ : state) {
+        std::fill(x.data(), x.data() + n, T(0));
+        const auto result = ilu ? linalg::conjugate_gradient(A, b, x, options, factors, &ws)
+                                : linalg::conjugate_gradient(A, b, x, options, jacobi, &ws);
+        benchmark::DoNotOptimize(result);
+    }
+    set_rates(state, 50.0 * (2.0 * A.nonzeros() + 10.0 * n + (ilu ? 2.0 * A.nonzeros() : n)), 0.0);
+}
+BENCHMARK_TEMPLATE(BM_conjugate_gradient, double)
+    ->ArgNames({"grid", "ilu", "threads"})
+    ->ArgsProduct({{64, 256, 1024}, {0, 1}, thread_counts()})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * BENCHMARK: factor and solve an n x n band matrix (kl = ku = bandwidth)
+ *
+ * About 2·n·kl·(kl + ku) flops for the LU with pivoting, plus the solve
+ */
+template<typename T>
+void BM_banded_solve(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t bandwidth = static_cast<size_t>(state.range(1));
+    use_one_thread();
+    linalg::BandedMatrix<T> A(n, bandwidth, bandwidth);
+    const Vector<T> values = random_vector<T>(n * A.width(), 17u);
+    std::copy(values.data(), values.data() + n * A.width(), A.data());
+    for (size_t i = 0; i < n; ++i) A(i, i) += T(2 * bandwidth + 1);
+    const Vector<T> b = random_vector<T>(n);
+    for (auto _ : state) {
+        Vector<T> x = linalg::BandedLU<T>(A).solve(b);
+        benchmark::DoNotOptimize(x.data());
+    }
+    set_rates(state, 2.0 * n * bandwidth * (3.0 * bandwidth + 2.0), 0.0);
+}
+BENCHMARK_TEMPLATE(BM_banded_solve, double)
+    ->ArgNames({"n", "bandwidth"})
+    ->ArgsProduct({{1000, 100000}, {1, 4, 16}});
+
+/**
+ * BENCHMARK: 4096 independent tridiagonal systems of size n (Thomas, 8n flops each)
+ */
+template<typename T>
+void BM_tridiagonal_batched(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    const size_t count = 4096, total = count * n;
+    const Vector<T> lower = random_vector<T>(total, 21u);
+    const Vector<T> upper = random_vector<T>(total, 22u);
+    Vector<T> diag(total);
+    std::fill(diag.data(), diag.data() + total, T(4));
+    const Vector<T> rhs = random_vector<T>(total, 23u);
+    Vector<T> x(total);
+    for (auto _ : state) {
+        std::copy(rhs.data(), rhs.data() + total, x.data());
+        linalg::solve_tridiagonal_batched(count, n, lower.data(), diag.data(), upper.data(), x.data());
+        benchmark::DoNotOptimize(x.data());
+    }
+    set_rates(state, 8.0 * total, 5.0 * total * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_tridiagonal_batched, double)
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{16, 256}, thread_counts()})
+    ->UseRealTime();
+
+/**
+ * BENCHMARK: B = Aᵀ out of place (reads and writes n² elements)
+ */
+template<typename T>
+void BM_transpose(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    const Matrix<T> A = random_matrix<T>(n, n, 11u);
+    Matrix<T> B(n, n);
+    for (auto _ : state) {
+        B = A.transpose();
+        benchmark::DoNotOptimize(B.data());
+        benchmark::ClobberMemory();
+    }
+    set_rates(state, 0.0, 2.0 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_transpose, float)->Apply(sizes_and_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_transpose, double)->Apply(sizes_and_threads)->UseRealTime();
+
+/**
+ * BENCHMARK: A = Aᵀ in place, square (tile swaps) and 2:1 (cycle following)
+ *
+ * Only the square case runs in parallel; the thread sweep covers both so
+ * they stay comparable.
+ */
+template<typename T>
+void BM_transpose_in_place(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    const size_t rows = state.range(1) ? n : n / 2;
+    use_threads(state, 2);
+    Matrix<T> A = random_matrix<T>(rows, n, 12u);
+    for (auto _ : state) {
+        A.transpose_in_place();
+        benchmark::DoNotOptimize(A.data());
+        benchmark::ClobberMemory();
+    }
+    set_rates(state, 0.0, 2.0 * rows * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_transpose_in_place, double)
+    ->ArgNames({"n", "square", "threads"})
+    ->ArgsProduct({{256, 1024, 4096}, {1, 0}, thread_counts()})
+    ->UseRealTime();
+
+/**
+ * BENCHMARK: x·y (2n flops over 2n elements)
+ */
+template<typename T>
+void BM_dot(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_one_thread();
+    const Vector<T> x = random_vector<T>(n, 5u);
+    const Vector<T> y = random_vector<T>(n, 6u);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x.dot(y));
+    }
+    set_rates(state, 2.0 * n, 2.0 * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_dot, float)->Apply(vector_lengths);
+BENCHMARK_TEMPLATE(BM_dot, double)->Apply(vector_lengths);
+
+/**
+ * BENCHMARK: ‖x‖₂ (2n flops over n elements, plus the overflow check)
+ */
+template<typename T>
+void BM_norm(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_one_thread();
+    const Vector<T> x = random_vector<T>(n, 7u);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x.norm());
+    }
+    set_rates(state, 2.0 * n, static_cast<double>(n) * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_norm, float)->Apply(vector_lengths);
+BENCHMARK_TEMPLATE(BM_norm, double)->Apply(vector_lengths);
+
+/**
+ * BENCHMARK: reduced row echelon form of a square matrix (about 2n³ flops:
+ * every pivot eliminates its column from all other rows)
+ */
+template<typename T>
+void BM_rref(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    const Matrix<T> A = random_matrix<T>(n, n, 8u);
+    for (auto _ : state) {
+        Matrix<T> R = A.reduced_row_echelon_form();
+        benchmark::DoNotOptimize(R.data());
+    }
+    set_rates(state, 2.0 * n * n * n, 2.0 * n * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_rref, float)
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{4, 16, 64, 256, 1024}, thread_counts()})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_rref, double)
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{4, 16, 64, 256, 1024}, thread_counts()})
+    ->UseRealTime();
+
+/**
+ * BENCHMARK: A·x = b by LU with partial pivoting (2n³/3 + 2n² flops)
+ */
+template<typename T>
+void BM_solve(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    const Matrix<T> A = random_matrix<T>(n, n, 9u);
+    const Vector<T> b = random_vector<T>(n);
+    for (auto _ : state) {
+        Vector<T> x = linalg::solve_linear_system(A, b);
+        benchmark::DoNotOptimize(x.data());
+    }
+    set_rates(state, 2.0 * n * n * n / 3.0 + 2.0 * n * n, (n * n + 2.0 * n) * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_solve, float)->Apply(cubic_sizes_and_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_solve, double)->Apply(cubic_sizes_and_threads)->UseRealTime();
+
+/**
+ * BENCHMARK: A·x = b for symmetric positive-definite A by Cholesky (n³/3 flops)
+ */
+template<typename T>
+void BM_solve_spd(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    Matrix<T> A = random_matrix<T>(n, n, 10u);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < i; ++j) A(i, j) = A(j, i);
+    }
+    const Vector<T> b = random_vector<T>(n);
+    for (auto _ : state) {
+        Vector<T> x = linalg::solve_spd_system(A, b);
+        benchmark::DoNotOptimize(x.data());
+    }
+    set_rates(state, n * n * n / 3.0 + 2.0 * n * n, (n * n + 2.0 * n) * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_solve_spd, float)->Apply(cubic_sizes_and_threads)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_solve_spd, double)->Apply(cubic_sizes_and_threads)->UseRealTime();
+
+/**
+ * BENCHMARK: closed-form roll-pitch-yaw rotation applied to one point
+ */
+template<typename T>
+void BM_rotation_rpy(benchmark::State& state) {
+    T angle = T(0.1);
+    linalg::FixedVector<T, 3> p{T(1), T(2), T(3)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(angle);
+        p = linalg::fixed_rotation_rpy(angle, T(0.2), T(0.3)) * p;
+        benchmark::DoNotOptimize(p);
+    }
+    set_rates(state, 15.0, 0.0);
+}
+BENCHMARK_TEMPLATE(BM_rotation_rpy, float);
+BENCHMARK_TEMPLATE(BM_rotation_rpy, double);
+
+/**
+ * BENCHMARK: quaternion built from roll-pitch-yaw, then rotating one point
+ */
+template<typename T>
+void BM_quaternion_rotate(benchmark::State& state) {
+    T angle = T(0.1);
+    linalg::FixedVector<T, 3> p{T(1), T(2), T(3)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(angle);
+        p = linalg::Quaternion<T>::from_rpy(angle, T(0.2), T(0.3)).rotate(p);
+        benchmark::DoNotOptimize(p);
+    }
+}
+BENCHMARK_TEMPLATE(BM_quaternion_rotate, float);
+BENCHMARK_TEMPLATE(BM_quaternion_rotate, double);
+
+/**
+ * BENCHMARK: heap-allocated rotation_z(angle) * Vector, for comparison
+ */
+void BM_rotation_dynamic(benchmark::State& state) {
+    double angle = 0.1;
+    Vector<double> p(3);
+    p[0] = 1.0; p[1] = 2.0; p[2] = 3.0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(angle);
+        Vector<double> q = linalg::rotation_z(angle) * p;
+        benchmark::DoNotOptimize(q.data());
+    }
+    set_rates(state, 15.0, 0.0);
+}
+BENCHMARK(BM_rotation_dynamic);
+
+/**
+ * BENCHMARK: 3x3 rotation of an SoA point cloud in place (15 flops and
+ * 24 or 48 bytes of traffic per point)
+ */
+template<typename T>
+void BM_transform_points(benchmark::State& state) {
+    const size_t n = static_cast<size_t>(state.range(0));
+    use_threads(state);
+    std::vector<T> xs(n, T(1)), ys(n, T(2)), zs(n, T(3));
+    const auto r = linalg::fixed_rotation_rpy(T(1e-3), T(2e-3), T(3e-3));
+    for (auto _ : state) {
+        linalg::transform_points(r, xs.data(), ys.data(), zs.data(), n);
+        benchmark::ClobberMemory();
+    }
+    set_rates(state, 15.0 * n, 6.0 * n * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_transform_points, float)
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, thread_counts()})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_transform_points, double)
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{1 << 10, 1 << 16, 1 << 22}, thread_counts()})
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -52,19 +52,25 @@ int main() {
     std::cout << "• The rotation preserves the distance from the z-axis\n\n";
 
     // CONCEPT 3: Applying Transformation
-    // Convert point to matrix format for multiplication
-    Matrix<double> point_matrix(3, 1);
-    for (size_t i = 0; i < 3; ++i) {
-        point_matrix.at(i, 0) = point.at(i);
-    }
+    // Small transforms use the fixed-size types: no heap allocation, and
+    // the 3x3 times 3x1 product is unrolled by the compiler
+    linalg::Matrix3d fixed_rot_z = linalg::fixed_rotation_z(angle);
+    linalg::Vector3d fixed_point(point);  // Vector<double> -> FixedVector<double, 3>
 
     // Perform the rotation
-    Matrix<double> transformed = rot_z * point_matrix;
+    linalg::Vector3d transformed = fixed_rot_z * fixed_point;
 
     std::cout << "Transformed point: ("
-              << transformed.at(0, 0) << ", "
-              << transformed.at(1, 0) << ", "
-              << transformed.at(2, 0) << ")\n\n";
+              << transformed[0] << ", "
+              << transformed[1] << ", "
+              << transformed[2] << ")\n";
+
+    // The dynamic types multiply directly too: Matrix * Vector is a GEMV
+    Vector<double> transformed_dynamic = rot_z * point;
+    std::cout << "Same result with Matrix * Vector: ("
+              << transformed_dynamic.at(0) << ", "
+              << transformed_dynamic.at(1) << ", "
+              << transformed_dynamic.at(2) << ")\n\n";
 
     // CONCEPT 4: Understanding the Result
     std::cout << "ANALYSIS OF TRANSFORMATION:\n";
@@ -72,8 +78,8 @@ int main() {
               << point.at(0)*point.at(0) + point.at(1)*point.at(1) 
               << ") = 1.0\n";
     std::cout << "• New length = sqrt(" 
-              << transformed.at(0,0)*transformed.at(0,0) + 
-                 transformed.at(1,0)*transformed.at(1,0)
+              << transformed[0]*transformed[0] + 
+                 transformed[1]*transformed[1]
               << ") ≈ 1.0\n";
     std::cout << "• The length is preserved by rotation\n";
     std::cout << "• New angle is 45 degrees from x-axis\n";
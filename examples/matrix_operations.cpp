@@ -68,7 +68,10 @@ int main() {
     std::cout << "y = " << solution.at(1) << " (verify: " << solution.at(1) << " is the y-coordinate)\n";
 
     // Verification section
+    // A * solution is a matrix-vector product (GEMV) and should reproduce b
+    Vector<double> check = A * solution;
     std::cout << "\nVERIFICATION:\n";
+    std::cout << "A * solution = (" << check.at(0) << ", " << check.at(1) << ") ≈ (7, 3)\n";
     std::cout << "Equation 1: 3(" << solution.at(0) << ") + 2(" << solution.at(1) << ") = " 
               << (3 * solution.at(0) + 2 * solution.at(1)) << " ≈ 7\n";
     std::cout << "Equation 2: " << solution.at(0) << " + " << solution.at(1) << " = "
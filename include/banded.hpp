@@ -0,0 +1,517 @@
+#ifndef BANDED_HPP
+#define BANDED_HPP
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "gemv.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Banded matrices, banded LU / Cholesky and tridiagonal solvers
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Splines, 1D finite differences and many implicit time steppers produce
+ * matrices whose nonzeros hug the diagonal: a_ij = 0 unless
+ * -kl <= j - i <= ku. Storing only that band takes n·(kl + ku + 1)
+ * numbers instead of n², and elimination never leaves it:
+ *
+ *   - LU without pivoting keeps L within kl and U within ku diagonals
+ *   - Partial pivoting can swap a row up by at most kl, so U widens to
+ *     kl + ku diagonals (LAPACK gbtrf reserves the same extra space)
+ *   - Cholesky of a symmetric band with half-width p keeps L within p
+ *
+ * Factorization therefore costs O(n·kl·(kl + ku)) instead of O(n³), and
+ * each solve O(n·(kl + ku)). For a tridiagonal matrix (kl = ku = 1) the
+ * elimination collapses to the Thomas algorithm: one forward sweep and one
+ * back substitution, 8n flops.
+ *
+ * STORAGE:
+ * -------
+ * LAPACK stores the band by columns; this library is row-major, so the
+ * band is stored by rows. Row i keeps columns i - kl .. i + ku contiguously:
+ *
+ *   A(i, j) = band[i · (kl + ku + 1) + (j - i + kl)]
+ *
+ * Slots that fall outside the matrix (top-left and bottom-right corners)
+ * are unused. Contiguous row strips let the factorizations use the SIMD
+ * dot / axpy kernels.
+ */
+namespace linalg {
+
+namespace detail {
+
+// Narrow bands make most strips a few elements long, shorter than the
+// setup cost of a dispatched SIMD kernel; those run as plain loops
+constexpr size_t band_simd_limit = 16;
+
+template<typename T>
+T band_dot(size_t n, const T* x, const T* y) {
+    if (n >= band_simd_limit) return simd::dot(n, x, y);
+    T sum = T(0);
+    for (size_t i = 0; i < n; ++i) sum += x[i] * y[i];
+    return sum;
+}
+
+template<typename T>
+void band_axpy(size_t n, T alpha, const T* x, T* y) {
+    if (n >= band_simd_limit) {
+        simd::axpy(n, alpha, x, y);
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+} // namespace detail
+
+/**
+ * @brief Square n x n band matrix with kl sub- and ku superdiagonals
+ */
+template<typename T>
+class BandedMatrix {
+private:
+    size_t n;
+    size_t kl;
+    size_t ku;
+    std::vector<T> band;             // n rows of width kl + ku + 1
+
+public:
+    /**
+     * @brief Zero band matrix
+     *
+     * @throws std::invalid_argument if n == 0
+     */
+    BandedMatrix(size_t size, size_t lower, size_t upper)
+        : n(size), kl(lower), ku(upper), band(size * (lower + upper + 1), T(0)) {
+        if (size == 0) {
+            throw std::invalid_argument("Matrix dimensions must be positive");
+        }
+    }
+
+    /**
+     * @brief Copies the band of a square dense matrix (entries outside are dropped)
+     *
+     * @throws std::invalid_argument if A is not square
+     */
+    BandedMatrix(const Matrix<T>& A, size_t lower, size_t upper)
+        : BandedMatrix(A.get_rows(), lower, upper) {
+        if (A.get_rows() != A.get_cols()) {
+            throw std::invalid_argument("Banded storage requires a square matrix");
+        }
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = first_column(i); j <= last_column(i); ++j) (*this)(i, j) = A(i, j);
+        }
+    }
+
+    // Columns of row i that lie inside the band
+    size_t first_column(size_t i) const { return i > kl ? i - kl : 0; }
+    size_t last_column(size_t i) const { return std::min(n - 1, i + ku); }
+
+    bool in_band(size_t i, size_t j) const { return j + kl >= i && j <= i + ku; }
+
+    /**
+     * @brief Unchecked access to an element inside the band (asserted in debug builds)
+     */
+    T& operator()(size_t i, size_t j) noexcept {
+        assert(i < n && j < n && in_band(i, j));
+        return band[i * width() + (j + kl - i)];
+    }
+
+    const T& operator()(size_t i, size_t j) const noexcept {
+        assert(i < n && j < n && in_band(i, j));
+        return band[i * width() + (j + kl - i)];
+    }
+
+    /**
+     * @brief Checked access; elements outside the band read as zero
+     *
+     * @throws std::out_of_range if (i, j) is outside the matrix
+     */
+    T at(size_t i, size_t j) const {
+        if (i >= n || j >= n) {
+            throw std::out_of_range("Matrix index out of range");
+        }
+        return in_band(i, j) ? (*this)(i, j) : T(0);
+    }
+
+    /**
+     * @brief Checked write
+     *
+     * @throws std::out_of_range if (i, j) is outside the matrix or the band
+     */
+    void set(size_t i, size_t j, T value) {
+        if (i >= n || j >= n || !in_band(i, j)) {
+            throw std::out_of_range("Matrix index outside the band");
+        }
+        (*this)(i, j) = value;
+    }
+
+    Matrix<T> to_dense() const {
+        Matrix<T> dense(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = first_column(i); j <= last_column(i); ++j) dense(i, j) = (*this)(i, j);
+        }
+        return dense;
+    }
+
+    size_t get_rows() const { return n; }
+    size_t get_cols() const { return n; }
+    size_t size() const { return n; }
+    size_t lower_bandwidth() const { return kl; }
+    size_t upper_bandwidth() const { return ku; }
+
+    // Row-major band storage: row i starts at data() + i * width() with column i - kl
+    size_t width() const { return kl + ku + 1; }
+    T* data() noexcept { return band.data(); }
+    const T* data() const noexcept { return band.data(); }
+};
+
+/**
+ * @brief LU factorization with partial pivoting of a band matrix (LAPACK gbtrf)
+ *
+ * EDUCATIONAL NOTE:
+ * The factors are kept in band storage of width kl + (kl + ku) + 1: L's
+ * multipliers in the kl slots left of the diagonal, U in the kl + ku slots
+ * right of it. Each elimination step touches a (kl + 1) x (kl + ku + 1)
+ * window, and both rows involved are contiguous strips, so the update is
+ * one SIMD axpy per row.
+ *
+ *   linalg::BandedLU<double> lu(A);    // O(n·kl·(kl + ku))
+ *   Vector<double> x = lu.solve(b);    // O(n·(kl + ku))
+ *
+ * @throws std::runtime_error if A is singular
+ */
+template<typename T>
+class BandedLU {
+private:
+    size_t n;
+    size_t kl;
+    size_t ku;                       // of U after pivoting: kl + original ku
+    std::vector<T> factors;          // n rows of width kl + ku + 1
+    std::vector<size_t> pivots;
+
+    size_t width() const { return kl + ku + 1; }
+    T* row(size_t i) { return factors.data() + i * width(); }
+    const T* row(size_t i) const { return factors.data() + i * width(); }
+    // Position of column j inside the strip of row i
+    static size_t offset(size_t i, size_t j, size_t kl) { return j + kl - i; }
+
+public:
+    explicit BandedLU(const BandedMatrix<T>& A)
+        : n(A.size()), kl(A.lower_bandwidth()), ku(A.lower_bandwidth() + A.upper_bandwidth()),
+          factors(A.size() * (2 * A.lower_bandwidth() + A.upper_bandwidth() + 1), T(0)),
+          pivots(A.size()) {
+        using std::abs;
+        for (size_t i = 0; i < n; ++i) {
+            const T* source = A.data() + i * A.width();
+            std::copy(source, source + A.width(), row(i));
+        }
+
+        for (size_t k = 0; k < n; ++k) {
+            const size_t last_row = std::min(n - 1, k + kl);
+            const size_t last_col = std::min(n - 1, k + ku);
+            size_t p = k;
+            for (size_t i = k + 1; i <= last_row; ++i) {
+                if (abs(row(i)[offset(i, k, kl)]) > abs(row(p)[offset(p, k, kl)])) p = i;
+            }
+            pivots[k] = p;
+            if (row(p)[offset(p, k, kl)] == T(0)) {
+                throw std::runtime_error("Matrix is singular");
+            }
+            if (p != k) {
+                std::swap_ranges(row(k) + offset(k, k, kl), row(k) + offset(k, last_col, kl) + 1,
+                                 row(p) + offset(p, k, kl));
+            }
+            const T* pivot_row = row(k) + offset(k, k, kl);
+            for (size_t i = k + 1; i <= last_row; ++i) {
+                T* target = row(i) + offset(i, k, kl);
+                const T l = target[0] /= pivot_row[0];
+                if (l != T(0)) detail::band_axpy(last_col - k, -l, pivot_row + 1, target + 1);
+            }
+        }
+    }
+
+    /**
+     * @brief Solves A·x = b in place using the stored factors
+     */
+    void solve_in_place(T* b) const {
+        // L·y = P·b, L applied as the sequence of eliminations
+        for (size_t k = 0; k < n; ++k) {
+            if (pivots[k] != k) std::swap(b[k], b[pivots[k]]);
+            const size_t last_row = std::min(n - 1, k + kl);
+            for (size_t i = k + 1; i <= last_row; ++i) b[i] -= row(i)[offset(i, k, kl)] * b[k];
+        }
+        // U·x = y, U has ku superdiagonals
+        for (size_t i = n; i-- > 0;) {
+            const T* u = row(i) + offset(i, i, kl);
+            const size_t count = std::min(n - 1, i + ku) - i;
+            b[i] = (b[i] - detail::band_dot(count, u + 1, b + i + 1)) / u[0];
+        }
+    }
+
+    /**
+     * @brief Solves A·x = b in O(n·(kl + ku))
+     *
+     * @throws std::invalid_argument if b has the wrong size
+     */
+    Vector<T> solve(const Vector<T>& b) const {
+        if (b.size() != n) {
+            throw std::invalid_argument("Right-hand side size does not match LU factorization");
+        }
+        Vector<T> x(b);
+        solve_in_place(x.data());
+        return x;
+    }
+
+    size_t size() const { return n; }
+    const std::vector<size_t>& pivot_indices() const { return pivots; }
+};
+
+/**
+ * @brief Cholesky factorization A = L·Lᵀ of a symmetric positive-definite band
+ *
+ * EDUCATIONAL NOTE:
+ * Only the lower band (kl subdiagonals) of A is read. L has the same
+ * half-bandwidth p = kl, and every entry is a dot product of two row
+ * strips of at most p elements, so the cost is O(n·p²) with no pivoting.
+ *
+ * @throws std::runtime_error if A is not positive definite
+ */
+template<typename T>
+class BandedCholesky {
+private:
+    size_t n;
+    size_t p;
+    std::vector<T> factors;          // L by rows: columns i - p .. i
+
+    T* row(size_t i) { return factors.data() + i * (p + 1); }
+    const T* row(size_t i) const { return factors.data() + i * (p + 1); }
+
+public:
+    explicit BandedCholesky(const BandedMatrix<T>& A)
+        : n(A.size()), p(A.lower_bandwidth()), factors(A.size() * (A.lower_bandwidth() + 1)) {
+        using std::sqrt;
+        for (size_t i = 0; i < n; ++i) {
+            const T* source = A.data() + i * A.width();
+            std::copy(source, source + p + 1, row(i));
+        }
+        for (size_t i = 0; i < n; ++i) {
+            const size_t first = i > p ? i - p : 0;
+            T* li = row(i) + p - i;  // li[j] = L(i, j) for j in [first, i]
+            for (size_t j = first; j < i; ++j) {
+                const T* lj = row(j) + p - j;
+                li[j] = (li[j] - detail::band_dot(j - first, li + first, lj + first)) / lj[j];
+            }
+            const T d = li[i] - detail::band_dot(i - first, li + first, li + first);
+            if (!(d > T(0))) {
+                throw std::runtime_error("Matrix is not positive definite");
+            }
+            li[i] = sqrt(d);
+        }
+    }
+
+    /**
+     * @brief Solves A·x = b in place: L·y = b by rows, then Lᵀ·x = y by columns
+     */
+    void solve_in_place(T* b) const {
+        for (size_t i = 0; i < n; ++i) {
+            const size_t first = i > p ? i - p : 0;
+            const T* li = row(i) + p - i;
+            b[i] = (b[i] - detail::band_dot(i - first, li + first, b + first)) / li[i];
+        }
+        for (size_t i = n; i-- > 0;) {
+            const size_t first = i > p ? i - p : 0;
+            const T* li = row(i) + p - i;
+            b[i] /= li[i];
+            detail::band_axpy(i - first, -b[i], li + first, b + first);
+        }
+    }
+
+    /**
+     * @brief Solves A·x = b in O(n·p)
+     *
+     * @throws std::invalid_argument if b has the wrong size
+     */
+    Vector<T> solve(const Vector<T>& b) const {
+        if (b.size() != n) {
+            throw std::invalid_argument("Right-hand side size does not match Cholesky factorization");
+        }
+        Vector<T> x(b);
+        solve_in_place(x.data());
+        return x;
+    }
+
+    size_t size() const { return n; }
+};
+
+namespace detail {
+
+/**
+ * @brief Thomas algorithm: solves one tridiagonal system in place
+ *
+ * lower[i] multiplies x[i - 1] (lower[0] unused), upper[i] multiplies
+ * x[i + 1] (upper[n - 1] unused). x holds b on entry; work needs n - 1
+ * entries for the modified superdiagonal.
+ *
+ * @return false on a zero pivot (the system needs pivoting or is singular)
+ */
+template<typename T>
+bool thomas(size_t n, const T* lower, const T* diag, const T* upper, T* x, T* work) {
+    // One reciprocal per row: the division is the longest step of the chain
+    T pivot = diag[0];
+    if (pivot == T(0)) return false;
+    T inverse = T(1) / pivot;
+    x[0] *= inverse;
+    for (size_t i = 1; i < n; ++i) {
+        work[i - 1] = upper[i - 1] * inverse;
+        pivot = diag[i] - lower[i] * work[i - 1];
+        if (pivot == T(0)) return false;
+        inverse = T(1) / pivot;
+        x[i] = (x[i] - lower[i] * x[i - 1]) * inverse;
+    }
+    for (size_t i = n - 1; i-- > 0;) x[i] -= work[i] * x[i + 1];
+    return true;
+}
+
+// Strict row diagonal dominance, under which Thomas needs no pivoting
+template<typename T>
+bool diagonally_dominant(const BandedMatrix<T>& A) {
+    using std::abs;
+    for (size_t i = 0; i < A.size(); ++i) {
+        T off = T(0);
+        for (size_t j = A.first_column(i); j <= A.last_column(i); ++j) {
+            if (j != i) off += abs(A(i, j));
+        }
+        if (!(abs(A(i, i)) > off)) return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Solves a tridiagonal system (kl = ku = 1) with the Thomas algorithm
+ *
+ * No pivoting: safe for diagonally dominant or symmetric positive-definite
+ * matrices. Use BandedLU otherwise.
+ *
+ * @throws std::invalid_argument if A is not tridiagonal or b has the wrong size
+ * @throws std::runtime_error on a zero pivot
+ */
+template<typename T>
+Vector<T> solve_tridiagonal(const BandedMatrix<T>& A, const Vector<T>& b) {
+    if (A.lower_bandwidth() != 1 || A.upper_bandwidth() != 1) {
+        throw std::invalid_argument("Matrix is not tridiagonal");
+    }
+    const size_t n = A.size();
+    if (b.size() != n) {
+        throw std::invalid_argument("Invalid dimensions for linear system");
+    }
+    // Row i of the band is (lower, diag, upper), so the diagonals are
+    // strided views of the band storage; copy them out once
+    std::vector<T> diagonals(4 * n);
+    T* lower = diagonals.data();
+    T* diag = lower + n;
+    T* upper = diag + n;
+    T* work = upper + n;
+    for (size_t i = 0; i < n; ++i) {
+        const T* r = A.data() + i * 3;
+        lower[i] = r[0];
+        diag[i] = r[1];
+        upper[i] = r[2];
+    }
+    Vector<T> x(b);
+    if (!detail::thomas(n, lower, diag, upper, x.data(), work)) {
+        throw std::runtime_error("Tridiagonal solve hit a zero pivot");
+    }
+    return x;
+}
+
+/**
+ * @brief Solves count independent tridiagonal systems of size n in parallel
+ *
+ * EDUCATIONAL NOTE:
+ * One small tridiagonal solve is a sequential chain of 8n flops, far too
+ * little to split. Thousands of them (one per spline, grid line or
+ * pixel row) are trivially parallel: tasks take contiguous ranges of
+ * systems and each reuses one scratch buffer for all of its systems.
+ *
+ * System s occupies entries s·n .. s·n + n - 1 of every array, with the
+ * same conventions as a single system: lower[s·n] and upper[s·n + n - 1]
+ * are unused. rhs is overwritten by the solutions.
+ *
+ * @throws std::runtime_error if any system hits a zero pivot
+ */
+template<typename T>
+void solve_tridiagonal_batched(size_t count, size_t n, const T* lower, const T* diag,
+                               const T* upper, T* rhs) {
+    if (count == 0 || n == 0) return;
+    std::atomic<bool> failed{false};
+    detail::gemv_for_chunks(count, count * n * 8, 1, [&](size_t begin, size_t end) {
+        std::vector<T> work(n);
+        bool ok = true;
+        for (size_t s = begin; s < end; ++s) {
+            const size_t o = s * n;
+            ok &= detail::thomas(n, lower + o, diag + o, upper + o, rhs + o, work.data());
+        }
+        if (!ok) failed.store(true, std::memory_order_relaxed);
+    });
+    if (failed.load()) {
+        throw std::runtime_error("Tridiagonal solve hit a zero pivot");
+    }
+}
+
+/**
+ * @brief Solves A·x = b for a band matrix
+ *
+ * Diagonally dominant tridiagonal matrices take the Thomas fast path;
+ * everything else goes through BandedLU with partial pivoting.
+ *
+ * @throws std::invalid_argument on dimension mismatch
+ * @throws std::runtime_error if A is singular
+ */
+template<typename T>
+Vector<T> solve_banded_system(const BandedMatrix<T>& A, const Vector<T>& b) {
+    if (A.size() != b.size()) {
+        throw std::invalid_argument("Invalid dimensions for linear system");
+    }
+    if (A.lower_bandwidth() == 1 && A.upper_bandwidth() == 1 && detail::diagonally_dominant(A)) {
+        return solve_tridiagonal(A, b);
+    }
+    return BandedLU<T>(A).solve(b);
+}
+
+} // namespace linalg
+
+/**
+ * @brief Band matrix-vector product A·x, O(n·(kl + ku)), rows in parallel
+ *
+ * @throws std::invalid_argument if A.size() != x.size()
+ */
+template<typename T>
+Vector<T> operator*(const linalg::BandedMatrix<T>& A, const Vector<T>& x) {
+    const size_t n = A.size();
+    if (x.size() != n) {
+        throw std::invalid_argument("Matrix and vector dimensions mismatch for multiplication");
+    }
+    Vector<T> y(n);
+    const size_t kl = A.lower_bandwidth();
+    linalg::detail::gemv_for_chunks(n, n * A.width(), 8, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const size_t first = A.first_column(i);
+            const T* strip = A.data() + i * A.width() + (first + kl - i);
+            y[i] = linalg::detail::band_dot(A.last_column(i) - first + 1, strip, x.data() + first);
+        }
+    });
+    return y;
+}
+
+#endif // BANDED_HPP
@@ -0,0 +1,240 @@
+#ifndef EXPRESSION_HPP
+#define EXPRESSION_HPP
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief Expression templates for lazy, fused elementwise arithmetic
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Written naively, C = a*A + b*B - D creates a temporary matrix for every
+ * operator: a*A, b*B, their sum, and finally the difference. Each temporary
+ * is an allocation plus a full pass over memory, and elementwise arithmetic
+ * is limited by memory bandwidth, not by the FPU.
+ *
+ * Expression templates make each operator return a tiny object that only
+ * remembers its operands. The type of a*A + b*B - D is a tree
+ *
+ *   Binary<Binary<Unary<Matrix, Scale>, Unary<Matrix, Scale>, Add>, Matrix, Sub>
+ *
+ * and nothing is computed until it is assigned to a Matrix. The assignment
+ * then runs one loop that evaluates the whole tree per element: one output
+ * allocation, one pass over each input, no intermediates.
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * 1. CRTP: Matrix, Vector and every node derive from Expression<Self>, so
+ *    operators accept "any expression" without virtual calls
+ * 2. Linear indexing: every node exposes coeff(idx) over its row-major
+ *    elements, so the evaluation loop is a flat, vectorizable loop
+ * 3. Operand storage: leaves (Matrix, Vector) are held by reference, nodes
+ *    by value, so temporaries inside one expression never dangle
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - Shapes are checked when a node is built (std::invalid_argument)
+ * - Evaluation runs in fixed-length blocks that the compiler vectorizes,
+ *   and in parallel chunks on the thread pool for large sizes
+ * - Elementwise operations read and write the same index, so assigning an
+ *   expression to one of its own operands (C = C + A) is safe. Strided views
+ *   (view.hpp) can read the target at other indices (A = A.transpose());
+ *   overlaps() detects that, and the target then evaluates into a temporary
+ * - An expression holding references must not outlive its operands: do not
+ *   store `auto e = A + B;` beyond the lifetime of A and B
+ */
+namespace linalg {
+
+/**
+ * @brief Element count above which expressions are evaluated in parallel
+ */
+constexpr size_t expression_parallel_limit = size_t(1) << 18;
+
+/**
+ * @brief CRTP base of everything that can appear in an expression
+ *
+ * A derived class E provides value_type, is_leaf, get_rows(), get_cols(),
+ * coeff(idx), the idx-th element in row-major order, and
+ * overlaps(first, last): whether coeff may read memory in [first, last)
+ * at a position other than idx.
+ */
+template<typename E>
+struct Expression {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+namespace detail {
+
+// Leaves are referenced, intermediate nodes are copied into their parent
+template<typename E>
+using expression_operand = std::conditional_t<E::is_leaf, const E&, const E>;
+
+template<typename T>
+struct Negate {
+    T operator()(const T& x) const { return -x; }
+};
+
+template<typename T>
+struct ScaleBy {
+    T factor;
+    T operator()(const T& x) const { return factor * x; }
+};
+
+template<typename T>
+struct DivideBy {
+    T divisor;
+    T operator()(const T& x) const { return x / divisor; }
+};
+
+template<typename T>
+struct Add {
+    T operator()(const T& x, const T& y) const { return x + y; }
+};
+
+template<typename T>
+struct Subtract {
+    T operator()(const T& x, const T& y) const { return x - y; }
+};
+
+template<typename T>
+struct Assign {
+    T operator()(const T&, const T& y) const { return y; }
+};
+
+// Elements per block of the evaluation loop; a compile-time trip count lets
+// the compiler replace the block with vector instructions
+constexpr size_t expression_block = 16;
+
+template<typename T, typename E, typename Op>
+void evaluate_range(T* out, const E& expr, Op op, size_t begin, size_t end) {
+    size_t i = begin;
+    for (; i + expression_block <= end; i += expression_block) {
+        LINALG_IVDEP
+        for (size_t k = 0; k < expression_block; ++k) {
+            out[i + k] = op(out[i + k], expr.coeff(i + k));
+        }
+    }
+    for (; i < end; ++i) {
+        out[i] = op(out[i], expr.coeff(i));
+    }
+}
+
+/**
+ * @brief out[i] = op(out[i], expr.coeff(i)) for all n elements, in one pass
+ */
+template<typename T, typename E, typename Op>
+void evaluate(T* out, size_t n, const E& expr, Op op) {
+    if (n < expression_parallel_limit) {
+        evaluate_range(out, expr, op, 0, n);
+        return;
+    }
+    ThreadPool& pool = default_thread_pool();
+    const size_t threads = pool.num_threads();
+    if (threads == 1) {
+        evaluate_range(out, expr, op, 0, n);
+        return;
+    }
+    const size_t chunk = (std::max<size_t>(n / (4 * threads), 4096) + expression_block - 1)
+                         / expression_block * expression_block;
+    pool.parallel_for((n + chunk - 1) / chunk, [&](size_t c) {
+        evaluate_range(out, expr, op, c * chunk, std::min(n, (c + 1) * chunk));
+    });
+}
+
+} // namespace detail
+
+/**
+ * @brief Elementwise op(e) node: negation and scaling
+ */
+template<typename E, typename Op>
+class UnaryExpression : public Expression<UnaryExpression<E, Op>> {
+private:
+    detail::expression_operand<E> operand;
+    Op op;
+
+public:
+    using value_type = typename E::value_type;
+    static constexpr bool is_leaf = false;
+
+    UnaryExpression(const E& e, Op f) : operand(e), op(f) {}
+
+    size_t get_rows() const { return operand.get_rows(); }
+    size_t get_cols() const { return operand.get_cols(); }
+    value_type coeff(size_t idx) const { return op(operand.coeff(idx)); }
+    bool overlaps(const void* first, const void* last) const { return operand.overlaps(first, last); }
+};
+
+/**
+ * @brief Elementwise op(l, r) node: addition and subtraction
+ */
+template<typename L, typename R, typename Op>
+class BinaryExpression : public Expression<BinaryExpression<L, R, Op>> {
+private:
+    detail::expression_operand<L> lhs;
+    detail::expression_operand<R> rhs;
+    Op op;
+
+public:
+    using value_type = typename L::value_type;
+    static constexpr bool is_leaf = false;
+
+    BinaryExpression(const L& l, const R& r, Op f) : lhs(l), rhs(r), op(f) {
+        static_assert(std::is_same_v<typename L::value_type, typename R::value_type>,
+                      "Operands of an expression must have the same element type");
+        if (l.get_rows() != r.get_rows() || l.get_cols() != r.get_cols()) {
+            throw std::invalid_argument("Matrix dimensions mismatch for elementwise operation");
+        }
+    }
+
+    size_t get_rows() const { return lhs.get_rows(); }
+    size_t get_cols() const { return lhs.get_cols(); }
+    value_type coeff(size_t idx) const { return op(lhs.coeff(idx), rhs.coeff(idx)); }
+    bool overlaps(const void* first, const void* last) const {
+        return lhs.overlaps(first, last) || rhs.overlaps(first, last);
+    }
+};
+
+template<typename L, typename R>
+BinaryExpression<L, R, detail::Add<typename L::value_type>>
+operator+(const Expression<L>& l, const Expression<R>& r) {
+    return {l.self(), r.self(), {}};
+}
+
+template<typename L, typename R>
+BinaryExpression<L, R, detail::Subtract<typename L::value_type>>
+operator-(const Expression<L>& l, const Expression<R>& r) {
+    return {l.self(), r.self(), {}};
+}
+
+template<typename E>
+UnaryExpression<E, detail::Negate<typename E::value_type>>
+operator-(const Expression<E>& e) {
+    return {e.self(), {}};
+}
+
+template<typename S, typename E, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+UnaryExpression<E, detail::ScaleBy<typename E::value_type>>
+operator*(S s, const Expression<E>& e) {
+    return {e.self(), {static_cast<typename E::value_type>(s)}};
+}
+
+template<typename E, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+UnaryExpression<E, detail::ScaleBy<typename E::value_type>>
+operator*(const Expression<E>& e, S s) {
+    return {e.self(), {static_cast<typename E::value_type>(s)}};
+}
+
+template<typename E, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S>>>
+UnaryExpression<E, detail::DivideBy<typename E::value_type>>
+operator/(const Expression<E>& e, S s) {
+    return {e.self(), {static_cast<typename E::value_type>(s)}};
+}
+
+} // namespace linalg
+
+#endif // EXPRESSION_HPP
@@ -0,0 +1,271 @@
+#ifndef FIXED_MATRIX_HPP
+#define FIXED_MATRIX_HPP
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief Compile-time sized matrices and vectors for small transforms
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Matrix<T> is sized at run time, so every 3x3 rotation lives on the heap
+ * and every product goes through loops whose bounds the compiler cannot
+ * see. In graphics and robotics almost all matrices are 2x2, 3x3 or 4x4,
+ * and their sizes are known when the program is written.
+ *
+ * FixedMatrix<T, R, C> puts the sizes in the type:
+ * 1. Storage is a std::array of R*C elements: no allocation, the object
+ *    lives on the stack or inside other objects
+ * 2. Loop bounds are constants, so the compiler unrolls products completely
+ *    and keeps the elements in (SIMD) registers
+ * 3. Shape errors such as a 3x3 times a 4x1 fail to compile
+ * 4. Everything is constexpr: constant transforms can be built at compile time
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - Row-major storage, like Matrix<T>
+ * - FixedVector<T, N> is an alias of FixedMatrix<T, N, 1> (a column
+ *   vector), so matrix-vector products need no special case
+ * - Conversions to and from Matrix/Vector check the shape at run time
+ */
+namespace linalg {
+
+template<typename T, size_t R, size_t C>
+class FixedMatrix {
+private:
+    std::array<T, R * C> elements{};  // zero-initialized
+
+public:
+    using value_type = T;
+
+    constexpr FixedMatrix() = default;
+
+    /**
+     * @brief Constructs from R*C values listed row by row
+     *
+     * EDUCATIONAL NOTE:
+     *   constexpr FixedMatrix<double, 2, 2> m{1.0, 2.0,
+     *                                         3.0, 4.0};
+     */
+    template<typename... Values,
+             typename = std::enable_if_t<sizeof...(Values) == R * C &&
+                                         std::conjunction_v<std::is_arithmetic<Values>...>>>
+    constexpr FixedMatrix(Values... values) : elements{static_cast<T>(values)...} {}
+
+    /**
+     * @brief Copies a dynamic matrix of the same shape
+     *
+     * @throws std::invalid_argument if m is not R x C
+     */
+    explicit FixedMatrix(const Matrix<T>& m) {
+        if (m.get_rows() != R || m.get_cols() != C) {
+            throw std::invalid_argument("Matrix dimensions do not match fixed size");
+        }
+        std::copy(m.data(), m.data() + R * C, elements.begin());
+    }
+
+    /**
+     * @brief Copies a dynamic vector of length N into a FixedVector<T, N>
+     *
+     * @throws std::invalid_argument if v.size() != R
+     */
+    template<size_t Cols = C, typename = std::enable_if_t<Cols == 1>>
+    explicit FixedMatrix(const Vector<T>& v) {
+        if (v.size() != R) {
+            throw std::invalid_argument("Vector size does not match fixed size");
+        }
+        std::copy(v.data(), v.data() + R, elements.begin());
+    }
+
+    static constexpr FixedMatrix identity() {
+        static_assert(R == C, "Identity matrix must be square");
+        FixedMatrix result;
+        for (size_t i = 0; i < R; ++i) result(i, i) = T(1);
+        return result;
+    }
+
+    static constexpr size_t get_rows() { return R; }
+    static constexpr size_t get_cols() { return C; }
+    static constexpr size_t size() { return R * C; }
+
+    // Unchecked access; sizes are compile-time constants
+    constexpr T& operator()(size_t i, size_t j) { return elements[i * C + j]; }
+    constexpr const T& operator()(size_t i, size_t j) const { return elements[i * C + j]; }
+
+    // Linear (row-major) access; for FixedVector this is component i
+    constexpr T& operator[](size_t i) { return elements[i]; }
+    constexpr const T& operator[](size_t i) const { return elements[i]; }
+
+    // Element access with bounds checking
+    constexpr T& at(size_t i, size_t j) {
+        if (i >= R || j >= C) throw std::out_of_range("Matrix index out of bounds");
+        return elements[i * C + j];
+    }
+
+    constexpr const T& at(size_t i, size_t j) const {
+        if (i >= R || j >= C) throw std::out_of_range("Matrix index out of bounds");
+        return elements[i * C + j];
+    }
+
+    constexpr T* data() noexcept { return elements.data(); }
+    constexpr const T* data() const noexcept { return elements.data(); }
+
+    /**
+     * @brief Matrix product with the inner dimension checked at compile time
+     *
+     * EDUCATIONAL NOTE:
+     * With R, K and C known, these loops are unrolled completely: a 3x3
+     * times 3x1 product compiles to nine multiply-adds with no branches.
+     */
+    template<size_t K>
+    constexpr FixedMatrix<T, R, K> operator*(const FixedMatrix<T, C, K>& other) const {
+        FixedMatrix<T, R, K> result;
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < K; ++j) {
+                T sum = T();
+                for (size_t k = 0; k < C; ++k) {
+                    sum += (*this)(i, k) * other(k, j);
+                }
+                result(i, j) = sum;
+            }
+        }
+        return result;
+    }
+
+    constexpr FixedMatrix operator+(const FixedMatrix& other) const {
+        FixedMatrix result;
+        for (size_t i = 0; i < R * C; ++i) result.elements[i] = elements[i] + other.elements[i];
+        return result;
+    }
+
+    constexpr FixedMatrix operator-(const FixedMatrix& other) const {
+        FixedMatrix result;
+        for (size_t i = 0; i < R * C; ++i) result.elements[i] = elements[i] - other.elements[i];
+        return result;
+    }
+
+    constexpr FixedMatrix operator-() const {
+        FixedMatrix result;
+        for (size_t i = 0; i < R * C; ++i) result.elements[i] = -elements[i];
+        return result;
+    }
+
+    constexpr FixedMatrix operator*(T s) const {
+        FixedMatrix result;
+        for (size_t i = 0; i < R * C; ++i) result.elements[i] = elements[i] * s;
+        return result;
+    }
+
+    friend constexpr FixedMatrix operator*(T s, const FixedMatrix& m) { return m * s; }
+
+    constexpr FixedMatrix<T, C, R> transpose() const {
+        FixedMatrix<T, C, R> result;
+        for (size_t i = 0; i < R; ++i)
+            for (size_t j = 0; j < C; ++j)
+                result(j, i) = (*this)(i, j);
+        return result;
+    }
+
+    constexpr bool operator==(const FixedMatrix& other) const {
+        for (size_t i = 0; i < R * C; ++i) {
+            if (elements[i] != other.elements[i]) return false;
+        }
+        return true;
+    }
+    constexpr bool operator!=(const FixedMatrix& other) const { return !(*this == other); }
+
+    /**
+     * @brief Copies into a heap-allocated Matrix<T> of the same shape
+     */
+    Matrix<T> to_matrix() const {
+        Matrix<T> result(R, C, uninitialized);
+        std::copy(elements.begin(), elements.end(), result.data());
+        return result;
+    }
+
+    /**
+     * @brief Copies a FixedVector into a dynamic Vector<T>
+     */
+    template<size_t Cols = C, typename = std::enable_if_t<Cols == 1>>
+    Vector<T> to_vector() const {
+        Vector<T> result(R);
+        std::copy(elements.begin(), elements.end(), result.data());
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const FixedMatrix& m) {
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                os << std::setw(8) << std::fixed << std::setprecision(4) << m(i, j) << " ";
+            }
+            os << "\n";
+        }
+        return os;
+    }
+};
+
+/**
+ * @brief Column vector of N components
+ */
+template<typename T, size_t N>
+using FixedVector = FixedMatrix<T, N, 1>;
+
+using Matrix3d = FixedMatrix<double, 3, 3>;
+using Matrix4d = FixedMatrix<double, 4, 4>;
+using Vector3d = FixedVector<double, 3>;
+using Vector4d = FixedVector<double, 4>;
+using Matrix3f = FixedMatrix<float, 3, 3>;
+using Matrix4f = FixedMatrix<float, 4, 4>;
+using Vector3f = FixedVector<float, 3>;
+using Vector4f = FixedVector<float, 4>;
+
+template<typename T, size_t N>
+constexpr T dot(const FixedVector<T, N>& a, const FixedVector<T, N>& b) {
+    T sum = T();
+    for (size_t i = 0; i < N; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+template<typename T, size_t N>
+T norm(const FixedVector<T, N>& v) {
+    return std::sqrt(dot(v, v));
+}
+
+template<typename T>
+constexpr FixedVector<T, 3> cross(const FixedVector<T, 3>& a, const FixedVector<T, 3>& b) {
+    return {a[1] * b[2] - a[2] * b[1],
+            a[2] * b[0] - a[0] * b[2],
+            a[0] * b[1] - a[1] * b[0]};
+}
+
+/**
+ * @brief 4x4 homogeneous transform [R t; 0 1] from a rotation and a translation
+ *
+ * EDUCATIONAL NOTE:
+ * Appending a 1 to a 3D point, p' = H·[p; 1], applies the rotation and the
+ * translation in one product, so chains of rigid motions compose by
+ * multiplying their 4x4 matrices.
+ */
+template<typename T>
+constexpr FixedMatrix<T, 4, 4> homogeneous(const FixedMatrix<T, 3, 3>& rotation,
+                                           const FixedVector<T, 3>& translation = {}) {
+    FixedMatrix<T, 4, 4> h;
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) h(i, j) = rotation(i, j);
+        h(i, 3) = translation[i];
+    }
+    h(3, 3) = T(1);
+    return h;
+}
+
+} // namespace linalg
+
+#endif // FIXED_MATRIX_HPP
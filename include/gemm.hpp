@@ -0,0 +1,377 @@
+#ifndef GEMM_HPP
+#define GEMM_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * @brief Cache-blocked general matrix multiplication (GEMM) engine
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * The textbook triple loop C(i,j) += A(i,k) * B(k,j) performs the right number
+ * of flops but spends most of its time waiting on memory: every pass over B
+ * walks a column, touching a new cache line per multiply-add.
+ *
+ * High-performance libraries (GotoBLAS, BLIS, OpenBLAS) restructure the loops
+ * around the memory hierarchy:
+ *
+ *   for jc in steps of NC:            <- a KC x NC panel of B lives in L3
+ *     for pc in steps of KC:
+ *       pack B(pc:pc+KC, jc:jc+NC)
+ *       for ic in steps of MC:        <- an MC x KC block of A lives in L2
+ *         pack A(ic:ic+MC, pc:pc+KC)
+ *         for jr in steps of NR:      <- a KC x NR sliver of B lives in L1
+ *           for ir in steps of MR:
+ *             micro-kernel: MR x NR block of C held in registers
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * 1. Packing: copying blocks of A and B into contiguous, kernel-ordered
+ *    buffers so the micro-kernel streams through memory with unit stride
+ * 2. Register tiling: the micro-kernel keeps an MR x NR tile of C in
+ *    registers for the whole KC loop, so each loaded value is reused
+ *    MR (or NR) times
+ * 3. Zero padding: partial edge blocks are padded while packing, so the
+ *    micro-kernel never needs to handle ragged sizes
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - All operands are described by (pointer, row stride, column stride), so
+ *   row-major, column-major and transposed operands share one code path
+ * - Packing buffers are thread-local and grow-only: after the first call no
+ *   further heap allocation takes place
+ * - The micro-kernel is selected through select_micro_kernel<T>(); float and
+ *   double get the AVX2 / AVX-512 / NEON kernels chosen at start-up
+ * - Large products are split into 2D tiles of C and run in parallel on the
+ *   library's thread pool (thread_pool.hpp)
+ */
+namespace linalg {
+
+/**
+ * @brief Product volume (m * n * k) below which Matrix<T>::operator* keeps
+ * the simple triple loop; packing overhead dominates for tiny operands.
+ */
+constexpr size_t gemm_naive_limit = 32 * 32 * 32;
+
+/**
+ * @brief Product volume from which gemm() spreads work over the thread pool
+ */
+constexpr size_t gemm_parallel_limit = 128 * 128 * 128;
+
+/**
+ * @brief Whether the blocked engine may be used for element type T
+ *
+ * Packing buffers are raw storage, so only trivially copyable types qualify.
+ */
+template<typename T>
+constexpr bool gemm_supported = std::is_trivially_copyable_v<T>;
+
+namespace detail {
+
+/**
+ * @brief Cache blocking parameters
+ *
+ * KC x NR sliver of B should fit in L1, MC x KC block of A in L2 and
+ * KC x NC panel of B in L3. MC and NC are rounded down to multiples of the
+ * micro-kernel's MR and NR at run time.
+ */
+template<typename T>
+struct gemm_blocking {
+    static constexpr size_t kc = 256;
+    static constexpr size_t mc = 96;
+    static constexpr size_t nc = 4096;
+};
+
+template<>
+struct gemm_blocking<float> {
+    static constexpr size_t kc = 384;
+    static constexpr size_t mc = 96;
+    static constexpr size_t nc = 4096;
+};
+
+// Largest MR x NR tile any micro-kernel may use (edge-tile scratch size)
+constexpr size_t gemm_max_tile = 512;
+
+/**
+ * @brief Chooses the micro-kernel used for element type T
+ *
+ * float and double use the SIMD kernel selected at start-up (simd.hpp);
+ * other types use the portable register-tiled kernel.
+ */
+template<typename T>
+micro_kernel<T> select_micro_kernel() {
+    if constexpr (simd::has_kernels<T>) {
+        return simd::kernels<T>().gemm;
+    } else {
+        return {4, 8, &micro_kernel_generic<T, 4, 8>};
+    }
+}
+
+/**
+ * @brief Thread-local, grow-only, 64-byte aligned scratch buffer
+ */
+template<typename T>
+class pack_buffer {
+private:
+    T* ptr = nullptr;
+    size_t capacity = 0;
+
+public:
+    pack_buffer() = default;
+    pack_buffer(const pack_buffer&) = delete;
+    pack_buffer& operator=(const pack_buffer&) = delete;
+
+    ~pack_buffer() {
+        ::operator delete(ptr, std::align_val_t(64));
+    }
+
+    T* reserve(size_t n) {
+        if (n > capacity) {
+            ::operator delete(ptr, std::align_val_t(64));
+            ptr = nullptr;
+            ptr = static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(64)));
+            capacity = n;
+        }
+        return ptr;
+    }
+};
+
+template<typename T, int Slot>
+T* thread_pack_buffer(size_t n) {
+    thread_local pack_buffer<T> buffer;
+    return buffer.reserve(n);
+}
+
+/**
+ * @brief Packs an mc x kc block of A into MR-row slivers
+ *
+ * Layout: for each sliver, kc consecutive groups of mr values (one column
+ * of the sliver per group). Rows past mc are zero-padded.
+ */
+template<typename T>
+void pack_a(size_t mc, size_t kc, const T* a, size_t rsa, size_t csa, size_t mr, T* buf) {
+    for (size_t i0 = 0; i0 < mc; i0 += mr) {
+        const size_t ib = std::min(mr, mc - i0);
+        const T* sliver = a + i0 * rsa;
+        for (size_t p = 0; p < kc; ++p) {
+            const T* col = sliver + p * csa;
+            size_t i = 0;
+            for (; i < ib; ++i) {
+                buf[i] = col[i * rsa];
+            }
+            for (; i < mr; ++i) {
+                buf[i] = T();
+            }
+            buf += mr;
+        }
+    }
+}
+
+/**
+ * @brief Packs a kc x nc panel of B into NR-column slivers
+ *
+ * Layout: for each sliver, kc consecutive groups of nr values (one row of
+ * the sliver per group). Columns past nc are zero-padded.
+ */
+template<typename T>
+void pack_b(size_t kc, size_t nc, const T* b, size_t rsb, size_t csb, size_t nr, T* buf) {
+    for (size_t j0 = 0; j0 < nc; j0 += nr) {
+        const size_t jb = std::min(nr, nc - j0);
+        const T* sliver = b + j0 * csb;
+        for (size_t p = 0; p < kc; ++p) {
+            const T* row = sliver + p * rsb;
+            size_t j = 0;
+            if (csb == 1) {
+                for (; j < jb; ++j) {
+                    buf[j] = row[j];
+                }
+            } else {
+                for (; j < jb; ++j) {
+                    buf[j] = row[j * csb];
+                }
+            }
+            for (; j < nr; ++j) {
+                buf[j] = T();
+            }
+            buf += nr;
+        }
+    }
+}
+
+/**
+ * @brief Runs the micro-kernel over every MR x NR tile of an mc x nc block
+ *
+ * Full tiles with unit column stride are updated in place; edge tiles (and
+ * non-unit-stride C) go through a small scratch tile. With accumulate ==
+ * false the block of C is overwritten without being read (first k panel of
+ * a beta == 0 product).
+ */
+template<typename T>
+void macro_kernel(const micro_kernel<T>& kern, size_t mc, size_t nc, size_t kc, T alpha,
+                  const T* apack, const T* bpack, T* c, size_t rsc, size_t csc, bool accumulate) {
+    const size_t mr = kern.mr;
+    const size_t nr = kern.nr;
+    T tile[gemm_max_tile];
+
+    for (size_t jr = 0; jr < nc; jr += nr) {
+        const size_t nb = std::min(nr, nc - jr);
+        const T* bp = bpack + jr * kc;
+        for (size_t ir = 0; ir < mc; ir += mr) {
+            const size_t mb = std::min(mr, mc - ir);
+            const T* ap = apack + ir * kc;
+            T* cp = c + ir * rsc + jr * csc;
+            if (mb == mr && nb == nr && csc == 1) {
+                kern.fn(kc, alpha, ap, bp, cp, rsc, accumulate);
+            } else {
+                kern.fn(kc, alpha, ap, bp, tile, nr, false);
+                for (size_t i = 0; i < mb; ++i) {
+                    for (size_t j = 0; j < nb; ++j) {
+                        T& cij = cp[i * rsc + j * csc];
+                        cij = accumulate ? cij + tile[i * nr + j] : tile[i * nr + j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes C = beta * C in place (beta == 0 overwrites, so NaNs in
+ * uninitialized output do not propagate)
+ */
+template<typename T>
+void scale_matrix(size_t m, size_t n, T beta, T* c, size_t rsc, size_t csc) {
+    if (beta == T(1)) return;
+    for (size_t i = 0; i < m; ++i) {
+        T* row = c + i * rsc;
+        for (size_t j = 0; j < n; ++j) {
+            row[j * csc] = (beta == T(0)) ? T() : beta * row[j * csc];
+        }
+    }
+}
+
+/**
+ * @brief Single-threaded blocked GEMM on one block of C
+ *
+ * The packing buffers are sized for an m_tile x n_tile block (default: this
+ * one), so every tile of a parallel product, edge tiles included, asks for
+ * the same sizes and a thread's buffers stop growing after its first tile.
+ */
+template<typename T>
+void gemm_serial(size_t m, size_t n, size_t k, T alpha,
+                 const T* a, size_t rsa, size_t csa,
+                 const T* b, size_t rsb, size_t csb,
+                 T beta, T* c, size_t rsc, size_t csc,
+                 size_t m_tile = 0, size_t n_tile = 0) {
+    if (m == 0 || n == 0) return;
+    if (k == 0 || alpha == T(0)) {
+        scale_matrix(m, n, beta, c, rsc, csc);
+        return;
+    }
+    // beta == 0: the first k panel stores into C instead of accumulating, so
+    // C is never zero-filled (or read) beforehand
+    if (beta != T(0)) scale_matrix(m, n, beta, c, rsc, csc);
+
+    const micro_kernel<T> kern = select_micro_kernel<T>();
+    const size_t mr = kern.mr;
+    const size_t nr = kern.nr;
+    const size_t kc_max = gemm_blocking<T>::kc;
+    const size_t mc_max = std::max(mr, gemm_blocking<T>::mc / mr * mr);
+    const size_t nc_max = std::max(nr, gemm_blocking<T>::nc / nr * nr);
+
+    const size_t kc_alloc = std::min(k, kc_max);
+    const size_t mc_alloc = (std::min(std::max(m, m_tile), mc_max) + mr - 1) / mr * mr;
+    const size_t nc_alloc = (std::min(std::max(n, n_tile), nc_max) + nr - 1) / nr * nr;
+    T* apack = thread_pack_buffer<T, 0>(mc_alloc * kc_alloc);
+    T* bpack = thread_pack_buffer<T, 1>(kc_alloc * nc_alloc);
+
+    for (size_t jc = 0; jc < n; jc += nc_max) {
+        const size_t nc = std::min(nc_max, n - jc);
+        for (size_t pc = 0; pc < k; pc += kc_max) {
+            const size_t kc = std::min(kc_max, k - pc);
+            pack_b(kc, nc, b + pc * rsb + jc * csb, rsb, csb, nr, bpack);
+            for (size_t ic = 0; ic < m; ic += mc_max) {
+                const size_t mc = std::min(mc_max, m - ic);
+                pack_a(mc, kc, a + ic * rsa + pc * csa, rsa, csa, mr, apack);
+                macro_kernel(kern, mc, nc, kc, alpha, apack, bpack,
+                             c + ic * rsc + jc * csc, rsc, csc, pc > 0 || beta != T(0));
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief General matrix multiply: C = alpha * A * B + beta * C
+ *
+ * EDUCATIONAL NOTE:
+ * Every operand is described by a pointer and two strides, so element (i,j)
+ * of A lives at a[i * rsa + j * csa]. A row-major matrix with leading
+ * dimension ld has strides (ld, 1); its transpose has strides (1, ld).
+ *
+ * PARALLELISM:
+ * Products of at least gemm_parallel_limit multiply-adds are split into
+ * 2D tiles of C (about four per thread, each a multiple of the register
+ * tile) and run on default_thread_pool(). Tiles are disjoint, so no
+ * synchronization is needed beyond the final join.
+ *
+ * @param m Rows of A and C
+ * @param n Columns of B and C
+ * @param k Columns of A / rows of B
+ */
+template<typename T>
+void gemm(size_t m, size_t n, size_t k, T alpha,
+          const T* a, size_t rsa, size_t csa,
+          const T* b, size_t rsb, size_t csb,
+          T beta, T* c, size_t rsc, size_t csc) {
+    static_assert(gemm_supported<T>, "gemm requires a trivially copyable element type");
+    if (m == 0 || n == 0) return;
+
+    ThreadPool& pool = default_thread_pool();
+    const size_t threads = pool.num_threads();
+    if (threads == 1 || m * n * k < gemm_parallel_limit) {
+        detail::gemm_serial(m, n, k, alpha, a, rsa, csa, b, rsb, csb, beta, c, rsc, csc);
+        return;
+    }
+
+    // Aim for ~4 tiles per thread, near-square, aligned to the register tile
+    const detail::micro_kernel<T> kern = detail::select_micro_kernel<T>();
+    const size_t mr = kern.mr;
+    const size_t nr = kern.nr;
+    const size_t area = std::max(m * n / (4 * threads), 16 * mr * nr);
+    const size_t side = static_cast<size_t>(std::sqrt(static_cast<double>(area)));
+    const size_t tile_m = std::min((m + mr - 1) / mr * mr, std::max(mr, (side + mr - 1) / mr * mr));
+    const size_t tile_n = std::min((n + nr - 1) / nr * nr,
+                                   std::max(nr, (area / tile_m + nr - 1) / nr * nr));
+    const size_t tiles_m = (m + tile_m - 1) / tile_m;
+    const size_t tiles_n = (n + tile_n - 1) / tile_n;
+
+    pool.parallel_for(tiles_m * tiles_n, [&](size_t tile) {
+        const size_t i0 = (tile / tiles_n) * tile_m;
+        const size_t j0 = (tile % tiles_n) * tile_n;
+        detail::gemm_serial(std::min(tile_m, m - i0), std::min(tile_n, n - j0), k, alpha,
+                            a + i0 * rsa, rsa, csa, b + j0 * csb, rsb, csb,
+                            beta, c + i0 * rsc + j0 * csc, rsc, csc, tile_m, tile_n);
+    });
+}
+
+/**
+ * @brief Row-major convenience overload: leading dimensions only
+ */
+template<typename T>
+void gemm(size_t m, size_t n, size_t k, T alpha,
+          const T* a, size_t lda, const T* b, size_t ldb,
+          T beta, T* c, size_t ldc) {
+    gemm(m, n, k, alpha, a, lda, size_t(1), b, ldb, size_t(1), beta, c, ldc, size_t(1));
+}
+
+} // namespace linalg
+
+#endif // GEMM_HPP
@@ -0,0 +1,108 @@
+#ifndef GEMV_HPP
+#define GEMV_HPP
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * @brief Matrix-vector products (GEMV)
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * y = alpha·A·x + beta·y touches every element of A exactly once and does
+ * one multiply-add with it. Unlike GEMM there is no data reuse to exploit,
+ * so GEMV runs at the speed of streaming A from memory. The rules for fast
+ * code are simple: read A contiguously, use SIMD, and let several cores
+ * stream in parallel.
+ *
+ * For row-major A the two variants have different natural shapes:
+ *
+ *   y = A·x      each y[i] is a dot product of row i with x
+ *                -> rows are independent, split rows across threads
+ *   y = Aᵀ·x     y accumulates x[i] · (row i), an axpy per row
+ *                -> columns are independent, split y across threads
+ *
+ * Both read A row by row, so neither walks down columns with a stride.
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - Inner loops are the dispatched SIMD dot/axpy kernels (simd.hpp)
+ * - beta == 0 overwrites y without reading it, as in BLAS
+ * - A has a leading dimension, so submatrices work without copies
+ */
+namespace linalg {
+
+/**
+ * @brief Matrix size (m * n) from which GEMV runs on the thread pool
+ */
+constexpr size_t gemv_parallel_limit = size_t(1) << 16;
+
+namespace detail {
+
+/**
+ * @brief Runs fn(begin, end) over chunks of [0, count), in parallel when
+ * the whole product touches at least gemv_parallel_limit elements of A
+ */
+template<typename F>
+void gemv_for_chunks(size_t count, size_t work, size_t granularity, F&& fn) {
+    if (work < gemv_parallel_limit) {
+        fn(size_t(0), count);
+        return;
+    }
+    ThreadPool& pool = default_thread_pool();
+    const size_t threads = pool.num_threads();
+    if (threads == 1) {
+        fn(size_t(0), count);
+        return;
+    }
+    const size_t chunk = (std::max(count / (4 * threads), granularity) + granularity - 1)
+                         / granularity * granularity;
+    pool.parallel_for((count + chunk - 1) / chunk, [&](size_t c) {
+        fn(c * chunk, std::min(count, (c + 1) * chunk));
+    });
+}
+
+template<typename T>
+void scale_vector(size_t n, T beta, T* y) {
+    if (beta == T(0)) {
+        std::fill(y, y + n, T(0));
+    } else if (beta != T(1)) {
+        simd::scal(n, beta, y);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief y := alpha·A·x + beta·y, A is m x n row-major with leading dimension lda
+ */
+template<typename T>
+void gemv(size_t m, size_t n, T alpha, const T* a, size_t lda, const T* x, T beta, T* y) {
+    detail::gemv_for_chunks(m, m * n, 8, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const T sum = simd::dot(n, a + i * lda, x);
+            y[i] = beta == T(0) ? alpha * sum : alpha * sum + beta * y[i];
+        }
+    });
+}
+
+/**
+ * @brief y := alpha·Aᵀ·x + beta·y, A is m x n row-major (x has m, y has n entries)
+ */
+template<typename T>
+void gemv_transposed(size_t m, size_t n, T alpha, const T* a, size_t lda, const T* x, T beta, T* y) {
+    // Each task owns a slice of y and sweeps all rows of A over it
+    detail::gemv_for_chunks(n, m * n, 64, [&](size_t begin, size_t end) {
+        detail::scale_vector(end - begin, beta, y + begin);
+        for (size_t i = 0; i < m; ++i) {
+            const T xi = alpha * x[i];
+            if (xi != T(0)) simd::axpy(end - begin, xi, a + i * lda + begin, y + begin);
+        }
+    });
+}
+
+} // namespace linalg
+
+#endif // GEMV_HPP
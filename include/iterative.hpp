@@ -0,0 +1,516 @@
+#ifndef ITERATIVE_HPP
+#define ITERATIVE_HPP
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "sparse.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Krylov subspace solvers (CG, BiCGSTAB, GMRES) and preconditioners
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Direct elimination costs O(n³) time and fills in sparse matrices, so at
+ * a million unknowns it is out of reach. Krylov methods instead build the
+ * solution from x0, A·r0, A²·r0, ... and only ever need the product y = A·x.
+ * A sparse A therefore costs O(nnz) per iteration, and A does not even have
+ * to be stored: any function computing A·x will do ("matrix-free").
+ *
+ * Which method:
+ * 1. Conjugate Gradient (CG): symmetric positive-definite A. Short
+ *    recurrences, minimal memory (4 vectors), error minimized in the A-norm
+ * 2. BiCGSTAB: general A, still short recurrences (7 vectors), but the
+ *    residual is not monotone and the method can break down
+ * 3. GMRES(m): general A, residual minimized over the subspace, which
+ *    needs all m basis vectors; restarting after m steps bounds the memory
+ *
+ * Preconditioning: the iteration count grows with the condition number of
+ * A. A preconditioner M ≈ A that is cheap to invert replaces A by M⁻¹A:
+ * - Jacobi: M = diag(A), one multiply per entry, helps with badly scaled rows
+ * - ILU(0): M = L·U, the LU factorization restricted to A's own sparsity
+ *   pattern, two sparse triangular solves per application
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - Operators: Matrix<T> (GEMV), SparseMatrix<T> (SpMV) or any callable
+ *   op(const Vector<T>& x, Vector<T>& y) computing y = A·x
+ * - Preconditioners: any type with apply(const Vector<T>& r, Vector<T>& z)
+ *   computing z = M⁻¹·r
+ * - All scratch vectors live in a KrylovWorkspace, allocated before the
+ *   first iteration; iterations only run BLAS-1 kernels and the operator.
+ *   Parallel SpMV / GEMV dispatch through the pool's grow-only queues, so
+ *   a solve that reuses a workspace allocates nothing on the calling thread
+ * - Convergence: ‖b - A·x‖ <= max(tolerance · ‖b‖, absolute_tolerance),
+ *   tracked through the residual recurrence of each method
+ */
+namespace linalg {
+
+/**
+ * @brief Stopping criteria shared by the Krylov solvers
+ */
+template<typename T>
+struct IterativeOptions {
+    T tolerance = T(1e-8);           // relative to ‖b‖
+    T absolute_tolerance = T(0);     // floor for b ≈ 0
+    size_t max_iterations = 1000;    // operator applications (GMRES: inner steps)
+    size_t restart = 30;             // GMRES basis size m
+};
+
+/**
+ * @brief Outcome of an iterative solve
+ */
+template<typename T>
+struct IterativeResult {
+    bool converged = false;
+    size_t iterations = 0;
+    T residual_norm = T(0);          // ‖b - A·x‖ / ‖b‖ (absolute if b = 0)
+};
+
+/**
+ * @brief Caller-owned scratch memory for the Krylov solvers
+ *
+ * EDUCATIONAL NOTE:
+ * Like LUWorkspace: the vectors (and GMRES' small Hessenberg system) are
+ * kept between solves and only replaced when n or the basis size grows,
+ * so repeated solves of the same size allocate nothing.
+ */
+template<typename T>
+struct KrylovWorkspace {
+    std::vector<Vector<T>> vectors;
+    std::vector<T> hessenberg;       // (m + 1) x m, column-major
+    std::vector<T> rotations;        // Givens cosines and sines, 2m
+    std::vector<T> rhs;              // rotated residual g, m + 1
+
+    // Ensures at least count vectors of length n; the workspace outlives any
+    // ArenaScope a solve runs in, so its vectors never come from an arena
+    void prepare(size_t n, size_t count) {
+        SystemAllocationScope system;
+        if (!vectors.empty() && vectors.front().size() != n) vectors.clear();
+        while (vectors.size() < count) vectors.emplace_back(n);
+    }
+};
+
+/**
+ * @brief M = I: leaves the residual unchanged
+ */
+template<typename T>
+struct IdentityPreconditioner {
+    void apply(const Vector<T>& r, Vector<T>& z) const {
+        std::copy(r.data(), r.data() + r.size(), z.data());
+    }
+};
+
+/**
+ * @brief M = diag(A): z[i] = r[i] / a_ii
+ *
+ * @throws std::runtime_error if a diagonal entry is zero or missing
+ */
+template<typename T>
+class JacobiPreconditioner {
+private:
+    std::vector<T> inverse_diagonal;
+
+    void set(size_t i, T d) {
+        if (d == T(0)) {
+            throw std::runtime_error("Jacobi preconditioner needs a nonzero diagonal");
+        }
+        inverse_diagonal[i] = T(1) / d;
+    }
+
+public:
+    explicit JacobiPreconditioner(const Matrix<T>& A) : inverse_diagonal(A.get_rows()) {
+        if (A.get_rows() != A.get_cols()) {
+            throw std::invalid_argument("Preconditioner requires a square matrix");
+        }
+        for (size_t i = 0; i < A.get_rows(); ++i) set(i, A(i, i));
+    }
+
+    explicit JacobiPreconditioner(const SparseMatrix<T>& A) : inverse_diagonal(A.get_rows()) {
+        if (A.get_rows() != A.get_cols()) {
+            throw std::invalid_argument("Preconditioner requires a square matrix");
+        }
+        for (size_t i = 0; i < A.get_rows(); ++i) set(i, A.at(i, i));
+    }
+
+    void apply(const Vector<T>& r, Vector<T>& z) const {
+        for (size_t i = 0; i < inverse_diagonal.size(); ++i) z[i] = r[i] * inverse_diagonal[i];
+    }
+};
+
+/**
+ * @brief Incomplete LU factorization with zero fill-in, M = L·U
+ *
+ * EDUCATIONAL NOTE:
+ * Gaussian elimination on a sparse matrix creates fill-in: entries that
+ * were zero in A but not in L and U. ILU(0) simply drops every update that
+ * would land outside A's pattern, so L and U fit in a copy of A (unit L
+ * strictly below the diagonal, U on and above) and applying M⁻¹ costs two
+ * sparse triangular solves, O(nnz).
+ *
+ * Row i is eliminated with the rows above it (IKJ order):
+ *   for each k < i in row i:   a_ik /= a_kk
+ *                              a_ij -= a_ik · a_kj  for j > k in both rows
+ *
+ * @throws std::runtime_error if a pivot is zero or missing from the pattern
+ */
+template<typename T>
+class ILU0Preconditioner {
+private:
+    SparseMatrix<T> factors;         // CSR, same pattern as A
+
+public:
+    explicit ILU0Preconditioner(const SparseMatrix<T>& A) : factors(A.to_format(sparse_format::csr)) {
+        const size_t n = factors.get_rows();
+        if (factors.get_cols() != n) {
+            throw std::invalid_argument("Preconditioner requires a square matrix");
+        }
+        const std::vector<size_t>& offsets = factors.outer_offsets();
+        const std::vector<size_t>& cols = factors.inner_indices();
+        std::vector<T>& vals = factors.values();
+
+        std::vector<size_t> diagonal(n);
+        for (size_t i = 0; i < n; ++i) {
+            auto it = std::lower_bound(cols.begin() + offsets[i], cols.begin() + offsets[i + 1], i);
+            if (it == cols.begin() + offsets[i + 1] || *it != i) {
+                throw std::runtime_error("ILU(0) needs every diagonal entry in the pattern");
+            }
+            diagonal[i] = static_cast<size_t>(it - cols.begin());
+        }
+
+        // position[j] = index of (i, j) in the current row i, or none
+        constexpr size_t none = std::numeric_limits<size_t>::max();
+        std::vector<size_t> position(n, none);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t p = offsets[i]; p < offsets[i + 1]; ++p) position[cols[p]] = p;
+            for (size_t p = offsets[i]; p < diagonal[i]; ++p) {
+                const size_t k = cols[p];
+                const T pivot = vals[diagonal[k]];
+                if (pivot == T(0)) {
+                    throw std::runtime_error("ILU(0) encountered a zero pivot");
+                }
+                const T lik = vals[p] /= pivot;
+                for (size_t q = diagonal[k] + 1; q < offsets[k + 1]; ++q) {
+                    const size_t target = position[cols[q]];
+                    if (target != none) vals[target] -= lik * vals[q];
+                }
+            }
+            if (vals[diagonal[i]] == T(0)) {
+                throw std::runtime_error("ILU(0) encountered a zero pivot");
+            }
+            for (size_t p = offsets[i]; p < offsets[i + 1]; ++p) position[cols[p]] = none;
+        }
+    }
+
+    void apply(const Vector<T>& r, Vector<T>& z) const {
+        std::copy(r.data(), r.data() + r.size(), z.data());
+        sparse_triangular_solve(factors, z, true, true);
+        sparse_triangular_solve(factors, z, false, false);
+    }
+
+    // Packed factors: unit L strictly below the diagonal, U on and above
+    const SparseMatrix<T>& lu() const { return factors; }
+};
+
+namespace detail {
+
+template<typename T>
+void apply_operator(const Matrix<T>& A, const Vector<T>& x, Vector<T>& y) {
+    gemv(T(1), A, x, T(0), y);
+}
+
+template<typename T>
+void apply_operator(const SparseMatrix<T>& A, const Vector<T>& x, Vector<T>& y) {
+    spmv(T(1), A, x, T(0), y);
+}
+
+template<typename Op, typename T>
+void apply_operator(const Op& op, const Vector<T>& x, Vector<T>& y) {
+    op(x, y);
+}
+
+template<typename T>
+T norm2(const Vector<T>& v) {
+    using std::sqrt;
+    return sqrt(simd::dot(v.size(), v.data(), v.data()));
+}
+
+// r := b - A·x
+template<typename Op, typename T>
+void residual(const Op& A, const Vector<T>& b, const Vector<T>& x, Vector<T>& r) {
+    apply_operator(A, x, r);
+    simd::axpby(b.size(), T(1), b.data(), T(-1), r.data());
+}
+
+template<typename T>
+void check_system(size_t rows, size_t cols, const Vector<T>& b, const Vector<T>& x) {
+    if (rows != cols || b.size() != rows || x.size() != rows) {
+        throw std::invalid_argument("Invalid dimensions for linear system");
+    }
+}
+
+/**
+ * @brief Shared bookkeeping: target residual and the reported result
+ */
+template<typename T>
+struct Convergence {
+    T b_norm;
+    T target;
+    IterativeResult<T> result;
+
+    Convergence(const Vector<T>& b, const IterativeOptions<T>& options)
+        : b_norm(norm2(b)), target(std::max(options.tolerance * b_norm, options.absolute_tolerance)) {}
+
+    bool check(T r_norm) {
+        result.residual_norm = b_norm > T(0) ? r_norm / b_norm : r_norm;
+        result.converged = r_norm <= target;
+        return result.converged;
+    }
+};
+
+template<typename Op, typename T>
+void check_operator(const Op& A, const Vector<T>& b, const Vector<T>& x) {
+    if constexpr (std::is_same_v<Op, Matrix<T>> || std::is_same_v<Op, SparseMatrix<T>>) {
+        check_system(A.get_rows(), A.get_cols(), b, x);
+    } else {
+        check_system(b.size(), b.size(), b, x);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Preconditioned Conjugate Gradient for symmetric positive-definite A
+ *
+ * EDUCATIONAL NOTE:
+ * Each step moves x along a search direction p that is A-conjugate to all
+ * previous ones (pᵢᵀ·A·pⱼ = 0), so no progress is ever undone; in exact
+ * arithmetic CG finishes in at most n steps. Per iteration: one operator
+ * application, one preconditioner application, two dot products and three
+ * vector updates.
+ *
+ * @param x Initial guess on entry, solution on exit
+ * @throws std::invalid_argument on dimension mismatch
+ */
+template<typename Op, typename T, typename Preconditioner = IdentityPreconditioner<T>>
+IterativeResult<T> conjugate_gradient(const Op& A, const Vector<T>& b, Vector<T>& x,
+                                      const IterativeOptions<T>& options = {},
+                                      const Preconditioner& M = Preconditioner(),
+                                      KrylovWorkspace<T>* workspace = nullptr) {
+    detail::check_operator(A, b, x);
+    const size_t n = b.size();
+    KrylovWorkspace<T> local;
+    KrylovWorkspace<T>& ws = workspace ? *workspace : local;
+    ws.prepare(n, 4);
+    Vector<T>& r = ws.vectors[0];
+    Vector<T>& z = ws.vectors[1];
+    Vector<T>& p = ws.vectors[2];
+    Vector<T>& q = ws.vectors[3];
+
+    detail::Convergence<T> status(b, options);
+    detail::residual(A, b, x, r);
+    if (status.check(detail::norm2(r))) return status.result;
+    M.apply(r, z);
+    std::copy(z.data(), z.data() + n, p.data());
+    T rz = simd::dot(n, r.data(), z.data());
+
+    while (status.result.iterations < options.max_iterations) {
+        detail::apply_operator(A, p, q);
+        ++status.result.iterations;
+        const T pq = simd::dot(n, p.data(), q.data());
+        if (pq == T(0)) break;  // breakdown: A is not positive definite
+        const T alpha = rz / pq;
+        simd::axpy(n, alpha, p.data(), x.data());
+        simd::axpy(n, -alpha, q.data(), r.data());
+        if (status.check(detail::norm2(r))) break;
+
+        M.apply(r, z);
+        const T rz_next = simd::dot(n, r.data(), z.data());
+        simd::axpby(n, T(1), z.data(), rz_next / rz, p.data());  // p = z + β·p
+        rz = rz_next;
+    }
+    return status.result;
+}
+
+/**
+ * @brief Right-preconditioned BiCGSTAB for general square A
+ *
+ * EDUCATIONAL NOTE:
+ * BiCG keeps CG's short recurrences for nonsymmetric A by working with a
+ * second "shadow" residual, but converges erratically. BiCGSTAB follows
+ * each BiCG step with a one-dimensional residual minimization (the ω
+ * step), which smooths convergence at the price of two operator
+ * applications per iteration. With right preconditioning the operator is
+ * A·M⁻¹, so the residual tracked is the true residual of A·x = b.
+ *
+ * @param x Initial guess on entry, solution on exit
+ * @throws std::invalid_argument on dimension mismatch
+ */
+template<typename Op, typename T, typename Preconditioner = IdentityPreconditioner<T>>
+IterativeResult<T> bicgstab(const Op& A, const Vector<T>& b, Vector<T>& x,
+                            const IterativeOptions<T>& options = {},
+                            const Preconditioner& M = Preconditioner(),
+                            KrylovWorkspace<T>* workspace = nullptr) {
+    detail::check_operator(A, b, x);
+    const size_t n = b.size();
+    KrylovWorkspace<T> local;
+    KrylovWorkspace<T>& ws = workspace ? *workspace : local;
+    ws.prepare(n, 7);
+    Vector<T>& r = ws.vectors[0];       // also holds s = r - α·v
+    Vector<T>& shadow = ws.vectors[1];
+    Vector<T>& p = ws.vectors[2];
+    Vector<T>& v = ws.vectors[3];
+    Vector<T>& p_hat = ws.vectors[4];
+    Vector<T>& s_hat = ws.vectors[5];
+    Vector<T>& t = ws.vectors[6];
+
+    detail::Convergence<T> status(b, options);
+    detail::residual(A, b, x, r);
+    if (status.check(detail::norm2(r))) return status.result;
+    std::copy(r.data(), r.data() + n, shadow.data());
+    std::fill(p.data(), p.data() + n, T(0));
+    std::fill(v.data(), v.data() + n, T(0));
+    T rho = T(1), alpha = T(1), omega = T(1);
+
+    while (status.result.iterations < options.max_iterations) {
+        const T rho_next = simd::dot(n, shadow.data(), r.data());
+        if (rho_next == T(0)) break;  // breakdown: residual orthogonal to the shadow
+        const T beta = (rho_next / rho) * (alpha / omega);
+        simd::axpy(n, -omega, v.data(), p.data());
+        simd::axpby(n, T(1), r.data(), beta, p.data());  // p = r + β·(p - ω·v)
+
+        M.apply(p, p_hat);
+        detail::apply_operator(A, p_hat, v);
+        ++status.result.iterations;
+        const T shadow_v = simd::dot(n, shadow.data(), v.data());
+        if (shadow_v == T(0)) break;
+        alpha = rho_next / shadow_v;
+        simd::axpy(n, -alpha, v.data(), r.data());  // r now holds s
+        if (status.check(detail::norm2(r))) {
+            simd::axpy(n, alpha, p_hat.data(), x.data());
+            break;
+        }
+
+        M.apply(r, s_hat);
+        detail::apply_operator(A, s_hat, t);
+        const T tt = simd::dot(n, t.data(), t.data());
+        omega = tt > T(0) ? simd::dot(n, t.data(), r.data()) / tt : T(0);
+        simd::axpy(n, alpha, p_hat.data(), x.data());
+        simd::axpy(n, omega, s_hat.data(), x.data());
+        simd::axpy(n, -omega, t.data(), r.data());
+        if (status.check(detail::norm2(r)) || omega == T(0)) break;
+        rho = rho_next;
+    }
+    return status.result;
+}
+
+/**
+ * @brief Restarted, right-preconditioned GMRES(m) for general square A
+ *
+ * EDUCATIONAL NOTE:
+ * GMRES builds an orthonormal basis V of the Krylov subspace with Arnoldi
+ * (modified Gram-Schmidt), which turns A·M⁻¹·V = V·H into a small
+ * (m + 1) x m Hessenberg least-squares problem. Givens rotations reduce H
+ * to triangular form column by column, and the last rotated right-hand
+ * side entry is the current residual norm, so convergence is known without
+ * forming x. After m steps the basis is discarded and the method restarts
+ * from the current x, bounding memory at m + 3 vectors.
+ *
+ * @param x Initial guess on entry, solution on exit
+ * @throws std::invalid_argument on dimension mismatch or restart == 0
+ */
+template<typename Op, typename T, typename Preconditioner = IdentityPreconditioner<T>>
+IterativeResult<T> gmres(const Op& A, const Vector<T>& b, Vector<T>& x,
+                         const IterativeOptions<T>& options = {},
+                         const Preconditioner& M = Preconditioner(),
+                         KrylovWorkspace<T>* workspace = nullptr) {
+    using std::abs;
+    using std::sqrt;
+    detail::check_operator(A, b, x);
+    if (options.restart == 0) {
+        throw std::invalid_argument("GMRES restart length must be positive");
+    }
+    const size_t n = b.size();
+    const size_t m = options.restart;
+    KrylovWorkspace<T> local;
+    KrylovWorkspace<T>& ws = workspace ? *workspace : local;
+    ws.prepare(n, m + 3);
+    ws.hessenberg.resize((m + 1) * m);
+    ws.rotations.resize(2 * m);
+    ws.rhs.resize(m + 1);
+    Vector<T>& w = ws.vectors[m + 1];
+    Vector<T>& z = ws.vectors[m + 2];
+    T* H = ws.hessenberg.data();
+    T* cs = ws.rotations.data();
+    T* sn = ws.rotations.data() + m;
+    T* g = ws.rhs.data();
+    auto h = [&](size_t i, size_t j) -> T& { return H[j * (m + 1) + i]; };
+
+    detail::Convergence<T> status(b, options);
+    while (true) {
+        detail::residual(A, b, x, w);
+        const T beta = detail::norm2(w);
+        if (status.check(beta) || status.result.iterations >= options.max_iterations) break;
+        Vector<T>& v0 = ws.vectors[0];
+        for (size_t i = 0; i < n; ++i) v0[i] = w[i] / beta;
+        std::fill(g, g + m + 1, T(0));
+        g[0] = beta;
+
+        size_t k = 0;
+        bool done = false;
+        while (k < m && status.result.iterations < options.max_iterations) {
+            M.apply(ws.vectors[k], z);
+            detail::apply_operator(A, z, w);
+            ++status.result.iterations;
+            for (size_t i = 0; i <= k; ++i) {
+                h(i, k) = simd::dot(n, w.data(), ws.vectors[i].data());
+                simd::axpy(n, -h(i, k), ws.vectors[i].data(), w.data());
+            }
+            const T h_next = detail::norm2(w);
+            h(k + 1, k) = h_next;
+            if (h_next > T(0)) {
+                Vector<T>& v_next = ws.vectors[k + 1];
+                for (size_t i = 0; i < n; ++i) v_next[i] = w[i] / h_next;
+            }
+
+            for (size_t i = 0; i < k; ++i) {
+                const T upper = cs[i] * h(i, k) + sn[i] * h(i + 1, k);
+                h(i + 1, k) = -sn[i] * h(i, k) + cs[i] * h(i + 1, k);
+                h(i, k) = upper;
+            }
+            const T radius = sqrt(h(k, k) * h(k, k) + h_next * h_next);
+            cs[k] = radius > T(0) ? h(k, k) / radius : T(1);
+            sn[k] = radius > T(0) ? h_next / radius : T(0);
+            h(k, k) = radius;
+            h(k + 1, k) = T(0);
+            g[k + 1] = -sn[k] * g[k];
+            g[k] = cs[k] * g[k];
+            ++k;
+
+            done = status.check(abs(g[k])) || h_next == T(0);
+            if (done) break;
+        }
+
+        // y = H⁻¹·g by back substitution (y overwrites g), then x += M⁻¹·(V·y)
+        for (size_t i = k; i-- > 0;) {
+            for (size_t j = i + 1; j < k; ++j) g[i] -= h(i, j) * g[j];
+            g[i] /= h(i, i);
+        }
+        std::fill(w.data(), w.data() + n, T(0));
+        for (size_t j = 0; j < k; ++j) simd::axpy(n, g[j], ws.vectors[j].data(), w.data());
+        M.apply(w, z);
+        simd::axpy(n, T(1), z.data(), x.data());
+        if (done && status.result.converged) break;
+    }
+    return status.result;
+}
+
+} // namespace linalg
+
+#endif // ITERATIVE_HPP
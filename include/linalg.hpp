@@ -4,6 +4,14 @@
 
 #include "matrix.hpp"
 #include "vector.hpp"
+#include "lu.hpp"
+#include "cholesky.hpp"
+#include "fixed_matrix.hpp"
+#include "rotation.hpp"
+#include "transform.hpp"
+#include "sparse.hpp"
+#include "iterative.hpp"
+#include "banded.hpp"
 #include <cmath>
 
 /**
@@ -39,17 +47,30 @@ namespace linalg {
  *   [0  cos(θ) -sin(θ)]
  *   [0  sin(θ)  cos(θ)]
  * 
+ * PERFORMANCE NOTE:
+ * fixed_rotation_x returns a stack-allocated FixedMatrix<T, 3, 3> whose
+ * products unroll completely; prefer it when transforming many points.
+ * 
+ * @param angle Rotation angle in radians
+ */
+template<typename T>
+FixedMatrix<T, 3, 3> fixed_rotation_x(T angle) {
+    const auto [s, c] = sincos(angle);
+    return {T(1), T(0), T(0),
+            T(0), c,    -s,
+            T(0), s,    c};
+}
+
+/**
+ * @brief Creates a 3D rotation matrix around the X axis as a dynamic Matrix
+ * 
+ * Heap-allocated copy of fixed_rotation_x (see there for the matrix form).
+ * 
  * @param angle Rotation angle in radians
  * @return Matrix<double> 3x3 rotation matrix
  */
-Matrix<double> rotation_x(double angle) {
-    Matrix<double> rot(3, 3);
-    rot.at(0, 0) = 1;
-    rot.at(1, 1) = std::cos(angle);
-    rot.at(1, 2) = -std::sin(angle);
-    rot.at(2, 1) = std::sin(angle);
-    rot.at(2, 2) = std::cos(angle);
-    return rot;
+inline Matrix<double> rotation_x(double angle) {
+    return fixed_rotation_x(angle).to_matrix();
 }
 
 /**
@@ -63,14 +84,24 @@ Matrix<double> rotation_x(double angle) {
  *   [   0     1    0   ]
  *   [-sin(θ)  0  cos(θ)]
  */
-Matrix<double> rotation_y(double angle) {
-    Matrix<double> rot(3, 3);
-    rot.at(0, 0) = std::cos(angle);
-    rot.at(0, 2) = std::sin(angle);
-    rot.at(1, 1) = 1;
-    rot.at(2, 0) = -std::sin(angle);
-    rot.at(2, 2) = std::cos(angle);
-    return rot;
+template<typename T>
+FixedMatrix<T, 3, 3> fixed_rotation_y(T angle) {
+    const auto [s, c] = sincos(angle);
+    return {c,    T(0), s,
+            T(0), T(1), T(0),
+            -s,   T(0), c};
+}
+
+/**
+ * @brief Creates a 3D rotation matrix around the Y axis as a dynamic Matrix
+ * 
+ * Heap-allocated copy of fixed_rotation_y (see there for the matrix form).
+ * 
+ * @param angle Rotation angle in radians
+ * @return Matrix<double> 3x3 rotation matrix
+ */
+inline Matrix<double> rotation_y(double angle) {
+    return fixed_rotation_y(angle).to_matrix();
 }
 
 /**
@@ -84,14 +115,49 @@ Matrix<double> rotation_y(double angle) {
  *   [sin(θ)  cos(θ)  0]
  *   [  0       0     1]
  */
-Matrix<double> rotation_z(double angle) {
-    Matrix<double> rot(3, 3);
-    rot.at(0, 0) = std::cos(angle);
-    rot.at(0, 1) = -std::sin(angle);
-    rot.at(1, 0) = std::sin(angle);
-    rot.at(1, 1) = std::cos(angle);
-    rot.at(2, 2) = 1;
-    return rot;
+template<typename T>
+FixedMatrix<T, 3, 3> fixed_rotation_z(T angle) {
+    const auto [s, c] = sincos(angle);
+    return {c,    -s,   T(0),
+            s,    c,    T(0),
+            T(0), T(0), T(1)};
+}
+
+/**
+ * @brief Creates a 3D rotation matrix around the Z axis as a dynamic Matrix
+ * 
+ * Heap-allocated copy of fixed_rotation_z (see there for the matrix form).
+ * 
+ * @param angle Rotation angle in radians
+ * @return Matrix<double> 3x3 rotation matrix
+ */
+inline Matrix<double> rotation_z(double angle) {
+    return fixed_rotation_z(angle).to_matrix();
+}
+
+/**
+ * @brief Roll-pitch-yaw rotation R = Rz(yaw)·Ry(pitch)·Rx(roll) in closed form
+ * 
+ * CLOSED-FORM COMPOSITION:
+ * - Roll about X, then pitch about Y, then yaw about Z (fixed axes), the
+ *   convention of aircraft and of ROS
+ * - Multiplying the three matrices symbolically leaves products of their
+ *   sines and cosines, so building R costs three sincos calls and a dozen
+ *   multiplications instead of two 3x3 products:
+ *   [cy·cp   cy·sp·sr - sy·cr   cy·sp·cr + sy·sr]
+ *   [sy·cp   sy·sp·sr + cy·cr   sy·sp·cr - cy·sr]
+ *   [ -sp         cp·sr              cp·cr      ]
+ * 
+ * See Quaternion<T>::from_rpy for the same rotation as a quaternion.
+ */
+template<typename T>
+FixedMatrix<T, 3, 3> fixed_rotation_rpy(T roll, T pitch, T yaw) {
+    const auto [sr, cr] = sincos(roll);
+    const auto [sp, cp] = sincos(pitch);
+    const auto [sy, cy] = sincos(yaw);
+    return {cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr,
+            sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr,
+            -sp,     cp * sr,                cp * cr};
 }
 
 /**
@@ -108,36 +174,148 @@ Matrix<double> rotation_z(double angle) {
  * 
  * Time Complexity: O(n³) where n is matrix dimension
  * 
+ * IMPLEMENTATION NOTE:
+ * Elimination is performed as an LU factorization with partial pivoting
+ * (see lu.hpp). When solving many systems with the same A, construct a
+ * linalg::LU<T> once and call its solve() for each right-hand side. Hot
+ * loops that must not allocate should use solve_in_place or
+ * solve_with_workspace with a reusable LUWorkspace.
+ * 
  * PRACTICAL APPLICATIONS:
  * - Circuit analysis
  * - Economic models
  * - Computer graphics (inverse kinematics)
+ * 
+ * @throws std::invalid_argument on dimension mismatch
+ * @throws std::runtime_error if A is singular
  */
 template<typename T>
 Vector<T> solve_linear_system(const Matrix<T>& A, const Vector<T>& b) {
     if (A.get_rows() != A.get_cols() || A.get_rows() != b.size()) {
         throw std::invalid_argument("Invalid dimensions for linear system");
     }
+    return LU<T>(A).solve(b);
+}
 
-    // Create augmented matrix [A|b]
-    Matrix<T> augmented(A.get_rows(), A.get_cols() + 1);
-    for (size_t i = 0; i < A.get_rows(); ++i) {
-        for (size_t j = 0; j < A.get_cols(); ++j) {
-            augmented.at(i, j) = A.at(i, j);
-        }
-        augmented.at(i, A.get_cols()) = b.at(i);
+/**
+ * @brief Solves A·x = b overwriting both inputs, using caller-owned scratch
+ * 
+ * MEMORY BEHAVIOUR:
+ * - A is overwritten with its LU factors (L below the diagonal, U on and
+ *   above) and b with the solution x
+ * - The only scratch memory is the pivot array in ws, which is reused, so
+ *   repeated calls perform no heap allocations on the calling thread once
+ *   ws has grown to n. Above lu_block_size the trailing updates run on the
+ *   thread pool, whose task queues are grow-only as well; a pool worker
+ *   allocates its GEMM packing buffers the first time it runs such a tile
+ * 
+ * @throws std::invalid_argument on dimension mismatch
+ * @throws std::runtime_error if A is singular (A and b are then clobbered)
+ */
+template<typename T>
+void solve_in_place(Matrix<T>& A, Vector<T>& b, LUWorkspace<T>& ws) {
+    const size_t n = A.get_rows();
+    if (A.get_cols() != n || b.size() != n) {
+        throw std::invalid_argument("Invalid dimensions for linear system");
     }
+    if (n == 0) return;
+    ws.pivots.resize(n);
+    if (detail::getrf(n, n, A.data(), n, ws.pivots.data()) != n) {
+        throw std::runtime_error("Matrix is singular");
+    }
+    detail::getrs(n, A.data(), n, ws.pivots.data(), b.data());
+}
 
-    // Solve using Gaussian elimination
-    Matrix<T> reduced = augmented.reduced_row_echelon_form();
+/**
+ * @brief Solves A·x = b overwriting both inputs (see above)
+ * 
+ * Allocates only the n pivot indices; pass an LUWorkspace to avoid even that.
+ */
+template<typename T>
+void solve_in_place(Matrix<T>& A, Vector<T>& b) {
+    LUWorkspace<T> ws;
+    solve_in_place(A, b, ws);
+}
+
+/**
+ * @brief Solves A·x = b into b, leaving A untouched
+ * 
+ * A is copied into ws.factors instead of a fresh matrix, so a loop that
+ * solves with a different A every iteration allocates nothing after the
+ * first call.
+ * 
+ * @throws std::invalid_argument on dimension mismatch
+ * @throws std::runtime_error if A is singular
+ */
+template<typename T>
+void solve_with_workspace(const Matrix<T>& A, Vector<T>& b, LUWorkspace<T>& ws) {
+    const size_t n = A.get_rows();
+    if (A.get_cols() != n || b.size() != n) {
+        throw std::invalid_argument("Invalid dimensions for linear system");
+    }
+    if (n == 0) return;
+    ws.factors.assign(A.data(), A.data() + n * n);
+    ws.pivots.resize(n);
+    if (detail::getrf(n, n, ws.factors.data(), n, ws.pivots.data()) != n) {
+        throw std::runtime_error("Matrix is singular");
+    }
+    detail::getrs(n, ws.factors.data(), n, ws.pivots.data(), b.data());
+}
+
+/**
+ * @brief Solves A·X = B for all columns of B with one factorization
+ * 
+ * MULTIPLE RIGHT-HAND SIDES:
+ * - A is factored once: (2/3)n³ flops
+ * - Every column of B then costs 2n² flops, performed as blocked,
+ *   multithreaded triangular solves (TRSM) instead of per-column loops
+ * - Column j of the result solves A·x = (column j of B)
+ * 
+ * @throws std::invalid_argument on dimension mismatch
+ * @throws std::runtime_error if A is singular
+ */
+template<typename T>
+Matrix<T> solve_linear_system(const Matrix<T>& A, const Matrix<T>& B) {
+    if (A.get_rows() != A.get_cols() || A.get_rows() != B.get_rows()) {
+        throw std::invalid_argument("Invalid dimensions for linear system");
+    }
+    return LU<T>(A).solve(B);
+}
 
-    // Extract solution vector
-    Vector<T> solution(b.size());
-    for (size_t i = 0; i < b.size(); ++i) {
-        solution.at(i) = reduced.at(i, A.get_cols());
+/**
+ * @brief Solves A·x = b for a symmetric positive-definite A
+ * 
+ * CHOLESKY FACTORIZATION:
+ * - Factors A = L·Lᵀ reading only the lower triangle of A
+ * - Half the flops and half the memory traffic of LU
+ * - Typical inputs: covariance matrices, normal equations AᵀA
+ * 
+ * @throws std::invalid_argument on dimension mismatch
+ * @throws std::runtime_error if A is not positive definite
+ */
+template<typename T>
+Vector<T> solve_spd_system(const Matrix<T>& A, const Vector<T>& b) {
+    if (A.get_rows() != A.get_cols() || A.get_rows() != b.size()) {
+        throw std::invalid_argument("Invalid dimensions for linear system");
     }
+    return Cholesky<T>(A).solve(b);
+}
 
-    return solution;
+/**
+ * @brief Solves A·x = b for a symmetric, possibly indefinite A
+ * 
+ * Uses the pivoted L·D·Lᵀ factorization, which keeps the symmetry (and the
+ * n³/3 cost) of Cholesky without requiring positive definiteness.
+ * 
+ * @throws std::invalid_argument on dimension mismatch
+ * @throws std::runtime_error if A is singular
+ */
+template<typename T>
+Vector<T> solve_symmetric_system(const Matrix<T>& A, const Vector<T>& b) {
+    if (A.get_rows() != A.get_cols() || A.get_rows() != b.size()) {
+        throw std::invalid_argument("Invalid dimensions for linear system");
+    }
+    return LDLT<T>(A).solve(b);
 }
 
 } // namespace linalg
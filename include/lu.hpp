@@ -0,0 +1,318 @@
+#ifndef LU_HPP
+#define LU_HPP
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "simd.hpp"
+#include "gemm.hpp"
+#include "trsm.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief LU factorization with partial pivoting
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Gaussian elimination secretly computes a factorization P·A = L·U:
+ * - L is unit lower triangular and stores the elimination multipliers
+ * - U is upper triangular (the row echelon form)
+ * - P records the row swaps chosen by partial pivoting
+ *
+ * Factoring costs (2/3)n³ flops once. Afterwards every right-hand side b is
+ * solved with two triangular substitutions, L·y = P·b and U·x = y, costing
+ * only 2n² flops. Gauss-Jordan on [A|b] instead redoes roughly n³ flops for
+ * every b and discards the work.
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * 1. Partial pivoting: using the largest remaining entry of a column as
+ *    pivot keeps multipliers |l| <= 1 and the algorithm numerically stable
+ * 2. In-place storage: L (without its unit diagonal) and U share the
+ *    storage of A, as in LAPACK's getrf
+ * 3. Factor once, solve many: the LU<T> object keeps the factors alive
+ * 4. Blocking: large matrices are factored panel by panel so that the
+ *    bulk of the work becomes matrix multiplication (see getrf)
+ */
+namespace linalg {
+
+/**
+ * @brief Panel width of the blocked LU factorization
+ */
+constexpr size_t lu_block_size = 128;
+
+namespace detail {
+
+/**
+ * @brief Unblocked right-looking LU of an m x n block (LAPACK getf2)
+ *
+ * Overwrites a with L and U; piv[k] is the row swapped with row k at step k
+ * (rows are swapped across the full n columns of the block).
+ *
+ * @return min(m, n) on success, otherwise the first step with a zero pivot
+ */
+template<typename T>
+size_t getf2(size_t m, size_t n, T* a, size_t lda, size_t* piv) {
+    using std::abs;
+    const size_t steps = std::min(m, n);
+    size_t info = steps;
+
+    for (size_t k = 0; k < steps; ++k) {
+        // Partial pivoting: largest magnitude in column k, rows k..m-1
+        size_t p = k;
+        auto best = abs(a[k * lda + k]);
+        for (size_t i = k + 1; i < m; ++i) {
+            const auto candidate = abs(a[i * lda + k]);
+            if (candidate > best) {
+                best = candidate;
+                p = i;
+            }
+        }
+        piv[k] = p;
+        if (a[p * lda + k] == T(0)) {
+            if (info == steps) info = k;
+            continue;
+        }
+        if (p != k) {
+            std::swap_ranges(a + k * lda, a + k * lda + n, a + p * lda);
+        }
+
+        // Rank-1 update of the trailing block, one contiguous row at a time
+        const T pivot = a[k * lda + k];
+        const T* pivot_row = a + k * lda + k + 1;
+        for (size_t i = k + 1; i < m; ++i) {
+            T* row = a + i * lda;
+            const T multiplier = row[k] /= pivot;
+            if (multiplier != T(0)) {
+                simd::axpy(n - k - 1, -multiplier, pivot_row, row + k + 1);
+            }
+        }
+    }
+    return info;
+}
+
+/**
+ * @brief Blocked right-looking LU with partial pivoting (LAPACK getrf)
+ *
+ * EDUCATIONAL NOTE:
+ * Each step factors a tall panel of lu_block_size columns, then updates the
+ * rest of the matrix with level-3 operations:
+ *
+ *   [A11 A12]      1. Panel:   P·[A11; A21] = [L11; L21]·U11   (getf2)
+ *   [A21 A22]      2. Swaps:   apply P to the columns outside the panel
+ *                  3. TRSM:    U12 = L11⁻¹·A12
+ *                  4. GEMM:    A22 = A22 - L21·U12             (parallel)
+ *
+ * Step 4 holds almost all of the (2/3)n³ flops and runs on the blocked,
+ * multithreaded GEMM engine.
+ *
+ * @return min(m, n) on success, otherwise the first step with a zero pivot
+ */
+template<typename T>
+size_t getrf_blocked(size_t m, size_t n, T* a, size_t lda, size_t* piv) {
+    const size_t steps = std::min(m, n);
+    size_t info = steps;
+    for (size_t j = 0; j < steps; j += lu_block_size) {
+        const size_t jb = std::min(lu_block_size, steps - j);
+
+        const size_t panel_info = getf2(m - j, jb, a + j * lda + j, lda, piv + j);
+        if (panel_info != jb && info == steps) info = j + panel_info;
+
+        for (size_t i = j; i < j + jb; ++i) {
+            piv[i] += j;
+            if (piv[i] != i) {
+                T* row = a + i * lda;
+                T* other = a + piv[i] * lda;
+                std::swap_ranges(row, row + j, other);
+                std::swap_ranges(row + j + jb, row + n, other + j + jb);
+            }
+        }
+
+        if (j + jb < n) {
+            T* a12 = a + j * lda + j + jb;
+            trsm_left_lower_unit(jb, n - j - jb, a + j * lda + j, lda, a12, lda);
+            if (j + jb < m) {
+                gemm(m - j - jb, n - j - jb, jb, T(-1), a + (j + jb) * lda + j, lda,
+                     a12, lda, T(1), a + (j + jb) * lda + j + jb, lda);
+            }
+        }
+    }
+    return info;
+}
+
+template<typename T>
+size_t getrf(size_t m, size_t n, T* a, size_t lda, size_t* piv) {
+    if constexpr (gemm_supported<T>) {
+        if (std::min(m, n) > lu_block_size) {
+            return getrf_blocked(m, n, a, lda, piv);
+        }
+    }
+    return getf2(m, n, a, lda, piv);
+}
+
+/**
+ * @brief Solves A·x = b in place given the factors from getrf (LAPACK getrs)
+ */
+template<typename T>
+void getrs(size_t n, const T* lu, size_t ld, const size_t* piv, T* b) {
+    for (size_t i = 0; i < n; ++i) {
+        if (piv[i] != i) std::swap(b[i], b[piv[i]]);
+    }
+    // Forward substitution with the unit lower triangle: L·y = P·b
+    for (size_t i = 1; i < n; ++i) {
+        b[i] -= simd::dot(i, lu + i * ld, b);
+    }
+    // Back substitution with the upper triangle: U·x = y
+    for (size_t i = n; i-- > 0;) {
+        const T* row = lu + i * ld;
+        b[i] = (b[i] - simd::dot(n - i - 1, row + i + 1, b + i + 1)) / row[i];
+    }
+}
+
+/**
+ * @brief Solves A·X = B in place for an n x nrhs block B (LAPACK getrs)
+ *
+ * EDUCATIONAL NOTE:
+ * With many right-hand sides the two substitutions become triangular
+ * solves with a matrix of unknowns (TRSM). Those are blocked so that most
+ * of the work is GEMM, which makes k right-hand sides far cheaper than k
+ * separate vector solves.
+ */
+template<typename T>
+void getrs(size_t n, size_t nrhs, const T* lu, size_t ld, const size_t* piv, T* b, size_t ldb) {
+    for (size_t i = 0; i < n; ++i) {
+        if (piv[i] != i) std::swap_ranges(b + i * ldb, b + i * ldb + nrhs, b + piv[i] * ldb);
+    }
+    if constexpr (gemm_supported<T>) {
+        trsm_left_lower_unit(n, nrhs, lu, ld, b, ldb);
+        trsm_left_upper(n, nrhs, lu, ld, b, ldb);
+    } else {
+        for (size_t i = 1; i < n; ++i) {
+            for (size_t p = 0; p < i; ++p) {
+                simd::axpy(nrhs, -lu[i * ld + p], b + p * ldb, b + i * ldb);
+            }
+        }
+        for (size_t i = n; i-- > 0;) {
+            for (size_t p = i + 1; p < n; ++p) {
+                simd::axpy(nrhs, -lu[i * ld + p], b + p * ldb, b + i * ldb);
+            }
+            simd::scal(nrhs, T(1) / lu[i * ld + i], b + i * ldb);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Caller-owned scratch memory for repeated linear solves
+ *
+ * EDUCATIONAL NOTE:
+ * Solving in a hot loop (time stepping, Newton iterations) should not hit
+ * the heap. A workspace keeps the pivot array, and a copy of A for solves
+ * that must not destroy their input, alive between calls: buffers only
+ * grow, so after the first (warm-up) solve of the largest size the calling
+ * thread allocates nothing more. (Blocked solves above lu_block_size also
+ * use the thread pool; its workers keep grow-only packing buffers of their
+ * own, allocated the first time each of them runs a GEMM tile.)
+ */
+template<typename T>
+struct LUWorkspace {
+    std::vector<T> factors;        // copy of A, overwritten by its LU factors
+    std::vector<size_t> pivots;    // LAPACK-style row interchanges
+
+    // Pre-sizes the buffers for n x n systems
+    void reserve(size_t n) {
+        factors.reserve(n * n);
+        pivots.reserve(n);
+    }
+};
+
+/**
+ * @brief Reusable LU factorization of a square matrix
+ *
+ * EDUCATIONAL NOTE:
+ * Construct once, then call solve() for as many right-hand sides as needed:
+ *
+ *   linalg::LU<double> lu(A);       // O(n³), done once
+ *   Vector<double> x = lu.solve(b); // O(n²) per right-hand side
+ *
+ * Passing an rvalue matrix factors it in place without copying.
+ *
+ * @throws std::invalid_argument if A is not square
+ * @throws std::runtime_error if A is singular
+ */
+template<typename T>
+class LU {
+private:
+    Matrix<T> lu;                  // L below the diagonal, U on and above
+    std::vector<size_t> pivots;    // LAPACK-style row interchanges
+
+public:
+    explicit LU(const Matrix<T>& A) : LU(Matrix<T>(A)) {}
+
+    explicit LU(Matrix<T>&& A) : lu(std::move(A)) {
+        if (lu.get_rows() != lu.get_cols()) {
+            throw std::invalid_argument("LU factorization requires a square matrix");
+        }
+        const size_t n = lu.get_rows();
+        pivots.resize(n);
+        if (detail::getrf(n, n, lu.data(), n, pivots.data()) != n) {
+            throw std::runtime_error("Matrix is singular");
+        }
+    }
+
+    /**
+     * @brief Solves A·x = b using the stored factors in O(n²)
+     */
+    Vector<T> solve(const Vector<T>& b) const {
+        if (b.size() != size()) {
+            throw std::invalid_argument("Right-hand side size does not match LU factorization");
+        }
+        Vector<T> x(b);
+        detail::getrs(size(), lu.data(), size(), pivots.data(), x.data());
+        return x;
+    }
+
+    /**
+     * @brief Solves A·X = B for every column of B at once
+     *
+     * The right-hand sides go through blocked triangular solves (see
+     * trsm.hpp), so the cost is dominated by GEMM rather than by n x k
+     * separate dot products.
+     */
+    Matrix<T> solve(const Matrix<T>& B) const {
+        if (B.get_rows() != size()) {
+            throw std::invalid_argument("Right-hand side size does not match LU factorization");
+        }
+        Matrix<T> X(B);
+        if (X.get_cols() > 0) {
+            detail::getrs(size(), X.get_cols(), lu.data(), size(), pivots.data(),
+                          X.data(), X.get_cols());
+        }
+        return X;
+    }
+
+    /**
+     * @brief det(A) = (-1)^swaps · product of U's diagonal
+     */
+    T determinant() const {
+        T det = T(1);
+        for (size_t i = 0; i < size(); ++i) {
+            det *= lu.at(i, i);
+            if (pivots[i] != i) det = -det;
+        }
+        return det;
+    }
+
+    size_t size() const { return lu.get_rows(); }
+
+    // Packed factors (L strictly below the diagonal, U on and above) and pivots
+    const Matrix<T>& factors() const { return lu; }
+    const std::vector<size_t>& pivot_indices() const { return pivots; }
+};
+
+} // namespace linalg
+
+#endif // LU_HPP
@@ -7,6 +7,34 @@
 #include <iostream>
 #include <iomanip>
 #include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <cassert>
+#include "gemm.hpp"
+#include "span.hpp"
+#include "storage.hpp"
+#include "view.hpp"
+#include "expression.hpp"
+
+template<typename T>
+class Matrix;
+
+namespace linalg {
+
+template<typename T>
+void assign_product(Matrix<T>& C, const Matrix<T>& A, const Matrix<T>& B);
+
+/**
+ * @brief Tag selecting the constructor that leaves elements uninitialized
+ *
+ *   Matrix<double> C(m, n, linalg::uninitialized);  // every element written later
+ */
+struct uninitialized_t {
+    explicit constexpr uninitialized_t() = default;
+};
+inline constexpr uninitialized_t uninitialized{};
+
+} // namespace linalg
 
 /**
  * @brief Template class for matrix operations
@@ -35,19 +63,103 @@
  * ---------------------
  * - Uses 1D array internally for better cache performance
  * - Row-major storage: element(i,j) = data[i * cols + j]
- * - Bounds checking on all element access
+ * - Bounds checking on at(); operator() and the span views are unchecked
+ *   fast paths for inner loops (asserted in debug builds)
+ * - Storage follows a linalg::StoragePolicy (alignment, huge pages, NUMA
+ *   placement; see storage.hpp), kept for every reallocation of the matrix
  * 
  * @tparam T The data type of matrix elements (typically float or double)
  */
 template<typename T>
-class Matrix {
+class Matrix : public linalg::Expression<Matrix<T>> {
 private:
     // Stores matrix elements in contiguous memory for cache efficiency
-    std::unique_ptr<T[]> data;  
+    linalg::storage_ptr<T> elements;  
     size_t rows;
     size_t cols;
+    size_t allocated = 0;  // capacity of elements; may exceed rows * cols after resize
+    linalg::StoragePolicy policy;
+
+    // Elimination steps touching fewer elements than this stay single-threaded
+    static constexpr size_t rref_parallel_limit = size_t(1) << 16;
+
+    /**
+     * @brief Allocates n elements without value-initializing them
+     * 
+     * EDUCATIONAL NOTE:
+     * Zero-filling a buffer that is about to be overwritten is a wasted
+     * pass over memory, and for large matrices it is also the first touch
+     * of each page, so it costs as much as the useful write. It also decides
+     * the NUMA node of every page under first-touch placement: leaving the
+     * pages untouched lets the (parallel) kernel that fills them place them
+     * next to the threads that use them.
+     */
+    linalg::storage_ptr<T> allocate_uninitialized(size_t n) const {
+        return linalg::allocate_storage<T>(n, policy, false);
+    }
+
+    friend void linalg::assign_product<>(Matrix<T>& C, const Matrix<T>& A, const Matrix<T>& B);
+
+    /**
+     * @brief this := a·b; the shape is already a.rows × b.cols and this
+     * aliases neither operand
+     */
+    void store_product(const Matrix& a, const Matrix& b) {
+        if constexpr (linalg::gemm_supported<T>) {
+            if (a.rows * a.cols * b.cols > linalg::gemm_naive_limit) {
+                linalg::gemm(a.rows, b.cols, a.cols, T(1), a.elements.get(), a.cols,
+                             b.elements.get(), b.cols, T(0), elements.get(), cols);
+                return;
+            }
+        }
+
+        // Dimensions were validated by the caller, so index the storage directly
+        for (size_t i = 0; i < a.rows; ++i) {
+            for (size_t j = 0; j < b.cols; ++j) {
+                T sum = T();
+                for (size_t k = 0; k < a.cols; ++k) {
+                    sum += a.elements[i * a.cols + k] * b.elements[k * b.cols + j];
+                }
+                elements[i * cols + j] = sum;
+            }
+        }
+    }
+
+    // Plain views are copied by the blocked row-copy / transpose kernels
+    template<typename E>
+    void assign_expression(const E& e) {
+        if constexpr (linalg::detail::is_matrix_view<E>::value) {
+            view().assign(e);
+        } else {
+            linalg::detail::evaluate(elements.get(), rows * cols, e, linalg::detail::Assign<T>());
+        }
+    }
+
+    // Whether e reads this matrix's elements at positions other than the one written
+    template<typename E>
+    bool reads_shifted(const E& e) const {
+        return elements && e.overlaps(elements.get(), elements.get() + allocated);
+    }
+
+    template<typename E>
+    void check_same_shape(const E& e) const {
+        if (e.get_rows() != rows || e.get_cols() != cols) {
+            throw std::invalid_argument("Matrix dimensions mismatch for elementwise operation");
+        }
+    }
+
+    static T magnitude(const T& value) {
+        if constexpr (std::is_unsigned_v<T>) {
+            return value;
+        } else {
+            return value < T(0) ? -value : value;
+        }
+    }
 
 public:
+    using value_type = T;
+    static constexpr bool is_leaf = true;  // held by reference inside expressions
+
     /**
      * @brief Constructor with size initialization
      * 
@@ -59,15 +171,45 @@ public:
      * 
      * This demonstrates RAII principle: resource management tied to object lifetime
      */
-    Matrix(size_t r, size_t c) : rows(r), cols(c) {
+    Matrix(size_t r, size_t c) : Matrix(r, c, linalg::default_storage_policy()) {}
+
+    /**
+     * @brief Zero-initialized matrix whose storage follows the given policy
+     * 
+     * EDUCATIONAL NOTE:
+     * A large matrix streamed by threads on every socket should interleave
+     * its pages over the NUMA nodes:
+     * 
+     *   linalg::StoragePolicy shared;
+     *   shared.placement = linalg::numa_placement::interleave;
+     *   shared.huge_pages = true;
+     *   Matrix<double> A(20000, 20000, shared);
+     */
+    Matrix(size_t r, size_t c, const linalg::StoragePolicy& storage) : rows(r), cols(c), policy(storage) {
         if (r == 0 || c == 0) {
             throw std::invalid_argument("Matrix dimensions must be positive");
         }
-        data = std::make_unique<T[]>(r * c);
-        // Initialize to zero (numerical stability)
-        for (size_t i = 0; i < r * c; ++i) {
-            data[i] = T();
+        elements = linalg::allocate_storage<T>(r * c, policy, true);
+        allocated = r * c;
+    }
+
+    /**
+     * @brief Constructor that leaves the elements uninitialized
+     * 
+     * EDUCATIONAL NOTE:
+     * For results that a kernel overwrites completely (products, copies,
+     * evaluated expressions) zero-filling first only doubles the memory
+     * traffic. Reading an element before it has been written is undefined
+     * behavior, so this is meant for code that fills every element.
+     */
+    Matrix(size_t r, size_t c, linalg::uninitialized_t,
+           const linalg::StoragePolicy& storage = linalg::default_storage_policy())
+        : rows(r), cols(c), policy(storage) {
+        if (r == 0 || c == 0) {
+            throw std::invalid_argument("Matrix dimensions must be positive");
         }
+        elements = allocate_uninitialized(r * c);
+        allocated = r * c;
     }
 
     /**
@@ -79,9 +221,10 @@ public:
      * 2. Independent object lifetime
      * 3. Thread safety
      */
-    Matrix(const Matrix& other) : rows(other.rows), cols(other.cols) {
-        data = std::make_unique<T[]>(rows * cols);
-        std::copy(other.data.get(), other.data.get() + (rows * cols), data.get());
+    Matrix(const Matrix& other)
+        : rows(other.rows), cols(other.cols), allocated(other.rows * other.cols), policy(other.policy) {
+        elements = allocate_uninitialized(rows * cols);
+        std::copy(other.elements.get(), other.elements.get() + (rows * cols), elements.get());
     }
 
     /**
@@ -92,13 +235,161 @@ public:
      * 1. Avoids unnecessary copying
      * 2. Particularly useful for large matrices
      * 3. Leaves source object in valid but unspecified state
+     * 
+     * A buffer from an arena is copied into system memory instead of being
+     * adopted: the new matrix may outlive the ArenaScope (push_back into an
+     * outer container, a returned value). That copy allocates; the move
+     * stays noexcept so std::vector<Matrix> still moves on growth, and an
+     * out-of-memory failure there terminates.
      */
     Matrix(Matrix&& other) noexcept 
-        : data(std::move(other.data)), rows(other.rows), cols(other.cols) {
+        : rows(other.rows), cols(other.cols), allocated(other.allocated), policy(other.policy) {
+        if (linalg::from_arena(other.elements)) {
+            linalg::SystemAllocationScope system;
+            elements = allocate_uninitialized(rows * cols);
+            std::copy(other.elements.get(), other.elements.get() + rows * cols, elements.get());
+            allocated = rows * cols;
+            other.elements.reset();
+        } else {
+            elements = std::move(other.elements);
+        }
         other.rows = 0;
         other.cols = 0;
+        other.allocated = 0;
+    }
+
+    /**
+     * @brief Copy assignment
+     * 
+     * EDUCATIONAL NOTE:
+     * The existing buffer is reused whenever it is large enough, so
+     * repeatedly assigning same-shaped matrices (C = A in a loop) costs a
+     * copy but no allocation.
+     */
+    Matrix& operator=(const Matrix& other) {
+        if (this != &other) {
+            resize(other.rows, other.cols);
+            std::copy(other.elements.get(), other.elements.get() + rows * cols, elements.get());
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment: takes over other's buffer, releasing our own
+     * 
+     * A buffer from an arena is copied instead: `result = A * B;` inside an
+     * ArenaScope must leave result valid after the scope has ended. As for
+     * the move constructor, that copy may allocate; an out-of-memory
+     * failure there terminates rather than breaking noexcept.
+     */
+    Matrix& operator=(Matrix&& other) noexcept {
+        if (linalg::from_arena(other.elements)) {
+            return *this = static_cast<const Matrix&>(other);
+        }
+        if (this != &other) {
+            elements = std::move(other.elements);
+            rows = other.rows;
+            cols = other.cols;
+            allocated = other.allocated;
+            policy = other.policy;
+            other.rows = 0;
+            other.cols = 0;
+            other.allocated = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Changes the shape, allocating only if the buffer is too small
+     * 
+     * EDUCATIONAL NOTE:
+     * Shrinking, or growing back within the capacity reached before, keeps
+     * the buffer: steady-state loops that produce same-shaped results then
+     * never touch the heap. Element values are unspecified after a resize
+     * that changes the shape (they are not moved to their new positions).
+     * A grown buffer never comes from an arena, since this matrix may
+     * predate the open ArenaScope (assignments resize through here too).
+     * 
+     * @throws std::invalid_argument if r or c is zero
+     */
+    void resize(size_t r, size_t c) {
+        if (r == 0 || c == 0) {
+            throw std::invalid_argument("Matrix dimensions must be positive");
+        }
+        if (r * c > allocated) {
+            linalg::SystemAllocationScope system;
+            elements = allocate_uninitialized(r * c);
+            allocated = r * c;
+        }
+        rows = r;
+        cols = c;
     }
 
+    // Number of elements the current buffer can hold without reallocating
+    size_t capacity() const noexcept { return allocated; }
+
+    // Alignment and placement used for this matrix's buffer
+    const linalg::StoragePolicy& storage_policy() const noexcept { return policy; }
+
+    /**
+     * @brief Evaluates an elementwise expression into a new matrix
+     * 
+     * EDUCATIONAL NOTE:
+     * Matrix<double> C = 2.0 * A + B - D; builds an expression tree and
+     * evaluates it here in a single pass (see expression.hpp), with no
+     * temporary matrices.
+     */
+    template<typename E>
+    Matrix(const linalg::Expression<E>& expr)
+        : Matrix(expr.self().get_rows(), expr.self().get_cols(), linalg::uninitialized) {
+        assign_expression(expr.self());
+    }
+
+    /**
+     * @brief Assigns an elementwise expression, reallocating only if the shape changes
+     * 
+     * The expression may refer to this matrix (C = C + A): every element is
+     * read and written at the same index. A view that reads this matrix at
+     * other positions (A = A.transpose()) is evaluated into a temporary first.
+     */
+    template<typename E>
+    Matrix& operator=(const linalg::Expression<E>& expr) {
+        const E& e = expr.self();
+        if (reads_shifted(e)) {
+            return *this = Matrix(e);
+        }
+        resize(e.get_rows(), e.get_cols());
+        assign_expression(e);
+        return *this;
+    }
+
+    // Fused in-place updates: C += a*A evaluates in one pass over C and A
+    template<typename E>
+    Matrix& operator+=(const linalg::Expression<E>& expr) {
+        check_same_shape(expr.self());
+        if (reads_shifted(expr.self())) {
+            return *this += Matrix(expr.self());
+        }
+        linalg::detail::evaluate(elements.get(), rows * cols, expr.self(), linalg::detail::Add<T>());
+        return *this;
+    }
+
+    template<typename E>
+    Matrix& operator-=(const linalg::Expression<E>& expr) {
+        check_same_shape(expr.self());
+        if (reads_shifted(expr.self())) {
+            return *this -= Matrix(expr.self());
+        }
+        linalg::detail::evaluate(elements.get(), rows * cols, expr.self(), linalg::detail::Subtract<T>());
+        return *this;
+    }
+
+    // Row-major element idx; the leaf of every expression tree
+    const T& coeff(size_t idx) const noexcept { return elements[idx]; }
+
+    // A Matrix operand is read at the index being written, which is always safe
+    bool overlaps(const void*, const void*) const noexcept { return false; }
+
     /**
      * @brief Element access with bounds checking
      * 
@@ -114,14 +405,33 @@ public:
         if (i >= rows || j >= cols) {
             throw std::out_of_range("Matrix index out of bounds");
         }
-        return data[i * cols + j];
+        return elements[i * cols + j];
     }
 
     const T& at(size_t i, size_t j) const {
         if (i >= rows || j >= cols) {
             throw std::out_of_range("Matrix index out of bounds");
         }
-        return data[i * cols + j];
+        return elements[i * cols + j];
+    }
+
+    /**
+     * @brief Unchecked element access
+     * 
+     * EDUCATIONAL NOTE:
+     * at() pays for a comparison and a possible throw on every access, which
+     * also keeps the compiler from vectorizing loops. Once the indices are
+     * known to be valid, operator() is just a load. Debug builds (without
+     * NDEBUG) still assert on out-of-range indices.
+     */
+    T& operator()(size_t i, size_t j) noexcept {
+        assert(i < rows && j < cols);
+        return elements[i * cols + j];
+    }
+
+    const T& operator()(size_t i, size_t j) const noexcept {
+        assert(i < rows && j < cols);
+        return elements[i * cols + j];
     }
 
     /**
@@ -135,22 +445,19 @@ public:
      * 
      * Time complexity: O(n³) for n×n matrices
      * Space complexity: O(n²) for result storage
+     *
+     * PERFORMANCE NOTE:
+     * Products larger than linalg::gemm_naive_limit are handed to the
+     * cache-blocked engine in gemm.hpp; only tiny products use the simple
+     * loop in store_product, where packing would cost more than it saves.
      */
     Matrix<T> operator*(const Matrix<T>& other) const {
         if (cols != other.rows) {
             throw std::invalid_argument("Matrix dimensions mismatch for multiplication");
         }
 
-        Matrix<T> result(rows, other.cols);
-        for (size_t i = 0; i < rows; ++i) {
-            for (size_t j = 0; j < other.cols; ++j) {
-                T sum = T();
-                for (size_t k = 0; k < cols; ++k) {
-                    sum += at(i, k) * other.at(k, j);
-                }
-                result.at(i, j) = sum;
-            }
-        }
+        Matrix<T> result(rows, other.cols, linalg::uninitialized);
+        result.store_product(*this, other);
         return result;
     }
 
@@ -167,47 +474,63 @@ public:
      * 1. Find pivot in current column
      * 2. Swap rows if necessary
      * 3. Eliminate entries below pivot
+     * 
+     * PERFORMANCE NOTE:
+     * - The pivot is the largest entry of the column (partial pivoting)
+     * - Rows are swapped and updated as contiguous ranges; entries left of
+     *   the pivot column are already zero and are skipped
+     * - Row updates are independent, so large matrices eliminate in parallel
+     * - To solve square systems prefer linalg::LU (lu.hpp), which does about
+     *   a third of the work and runs on the blocked GEMM engine
      */
     Matrix<T> reduced_row_echelon_form() const {
         Matrix<T> temp(*this);
-        size_t lead = 0;
-
-        for (size_t r = 0; r < rows; ++r) {
-            if (lead >= cols) return temp;
-
-            size_t i = r;
-            while (temp.at(i, lead) == 0) {
-                ++i;
-                if (i == rows) {
-                    i = r;
-                    ++lead;
-                    if (lead == cols) return temp;
+        T* a = temp.elements.get();
+        linalg::ThreadPool* pool = nullptr;
+
+        size_t r = 0;
+        for (size_t lead = 0; r < rows && lead < cols; ++lead) {
+            size_t pivot = r;
+            for (size_t i = r + 1; i < rows; ++i) {
+                if (magnitude(a[i * cols + lead]) > magnitude(a[pivot * cols + lead])) {
+                    pivot = i;
                 }
             }
+            if (a[pivot * cols + lead] == T(0)) continue;  // no pivot in this column
 
             // Row operations
-            if (i != r) {
-                for (size_t j = 0; j < cols; ++j) {
-                    std::swap(temp.at(i, j), temp.at(r, j));
-                }
+            T* pivot_row = a + r * cols;
+            if (pivot != r) {
+                std::swap_ranges(pivot_row, pivot_row + cols, a + pivot * cols);
             }
 
             // Normalize row
-            T div = temp.at(r, lead);
-            for (size_t j = 0; j < cols; ++j) {
-                temp.at(r, j) /= div;
+            const T div = pivot_row[lead];
+            for (size_t j = lead; j < cols; ++j) {
+                pivot_row[j] /= div;
             }
 
             // Eliminate column
-            for (size_t i = 0; i < rows; ++i) {
-                if (i != r) {
-                    T mult = temp.at(i, lead);
-                    for (size_t j = 0; j < cols; ++j) {
-                        temp.at(i, j) -= temp.at(r, j) * mult;
+            const size_t width = cols - lead;
+            auto eliminate_rows = [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    T* row = a + i * cols;
+                    const T mult = row[lead];
+                    if (i != r && mult != T(0)) {
+                        linalg::simd::axpy(width, -mult, pivot_row + lead, row + lead);
                     }
                 }
+            };
+            if (rows * width < rref_parallel_limit) {
+                eliminate_rows(0, rows);
+            } else {
+                if (!pool) pool = &linalg::default_thread_pool();
+                const size_t chunk = std::max<size_t>(16, rows / (4 * pool->num_threads()));
+                pool->parallel_for((rows + chunk - 1) / chunk, [&](size_t c) {
+                    eliminate_rows(c * chunk, std::min(rows, (c + 1) * chunk));
+                });
             }
-            ++lead;
+            ++r;
         }
 
         return temp;
@@ -217,6 +540,109 @@ public:
     size_t get_rows() const { return rows; }
     size_t get_cols() const { return cols; }
 
+    /**
+     * @brief Raw access to the row-major storage
+     * 
+     * EDUCATIONAL NOTE:
+     * Numerical kernels (factorizations, BLAS-style routines) work on plain
+     * pointers with a leading dimension: element (i,j) is data()[i * get_cols() + j].
+     * No bounds checking is performed through this pointer.
+     */
+    T* data() noexcept { return elements.get(); }
+    const T* data() const noexcept { return elements.get(); }
+
+    /**
+     * @brief Strides of the storage, in elements
+     * 
+     * Element (i,j) lives at data()[i * row_stride() + j * col_stride()].
+     * Kernels written in terms of strides keep working for strided views
+     * (MatrixView, e.g. transpose()), where col_stride() != 1.
+     */
+    size_t row_stride() const noexcept { return cols; }
+    size_t col_stride() const noexcept { return 1; }
+
+    /**
+     * @brief View of the whole row-major buffer (rows * cols elements)
+     */
+    linalg::Span<T> span() noexcept { return linalg::Span<T>(elements.get(), rows * cols); }
+    linalg::Span<const T> span() const noexcept {
+        return linalg::Span<const T>(elements.get(), rows * cols);
+    }
+
+    /**
+     * @brief Contiguous view of row i
+     * 
+     * @throws std::out_of_range if i >= rows
+     */
+    linalg::Span<T> row(size_t i) {
+        if (i >= rows) {
+            throw std::out_of_range("Matrix row index out of bounds");
+        }
+        return linalg::Span<T>(elements.get() + i * cols, cols);
+    }
+
+    linalg::Span<const T> row(size_t i) const {
+        if (i >= rows) {
+            throw std::out_of_range("Matrix row index out of bounds");
+        }
+        return linalg::Span<const T>(elements.get() + i * cols, cols);
+    }
+
+    /**
+     * @brief Strided view of the whole matrix (see view.hpp)
+     * 
+     * EDUCATIONAL NOTE:
+     * Views borrow the buffer: they cost O(1), see writes made through the
+     * matrix and vice versa, and become invalid when the matrix is resized
+     * or destroyed.
+     */
+    linalg::MatrixView<T> view() noexcept { return linalg::MatrixView<T>(elements.get(), rows, cols, cols); }
+    linalg::MatrixView<const T> view() const noexcept {
+        return linalg::MatrixView<const T>(elements.get(), rows, cols, cols);
+    }
+
+    /**
+     * @brief Aᵀ without copying: a view with rows/cols and strides swapped
+     * 
+     * Matrix<double> At = A.transpose(); materializes it when a copy is needed.
+     */
+    linalg::MatrixView<T> transpose() noexcept { return view().transpose(); }
+    linalg::MatrixView<const T> transpose() const noexcept { return view().transpose(); }
+
+    /**
+     * @brief Replaces the matrix by its transpose without a second buffer
+     * 
+     * EDUCATIONAL NOTE:
+     * Square matrices swap mirrored cache tiles; rectangular ones follow
+     * the permutation cycles of the row-major layout (see transpose.hpp).
+     * The cycle walk is much slower than Matrix<T> At = A.transpose();
+     * use it only when the extra copy does not fit in memory.
+     */
+    void transpose_in_place() {
+        linalg::transpose_in_place(rows, cols, elements.get());
+        std::swap(rows, cols);
+    }
+
+    /**
+     * @brief View of the nr x nc submatrix starting at (r0, c0)
+     * 
+     * @throws std::out_of_range if the block does not fit
+     */
+    linalg::MatrixView<T> block(size_t r0, size_t c0, size_t nr, size_t nc) {
+        return view().block(r0, c0, nr, nc);
+    }
+    linalg::MatrixView<const T> block(size_t r0, size_t c0, size_t nr, size_t nc) const {
+        return view().block(r0, c0, nr, nc);
+    }
+
+    /**
+     * @brief View of column j (stride cols)
+     * 
+     * @throws std::out_of_range if j >= cols
+     */
+    linalg::VectorView<T> column(size_t j) { return view().col(j); }
+    linalg::VectorView<const T> column(size_t j) const { return view().col(j); }
+
     /**
      * @brief Stream output operator
      * 
@@ -237,4 +663,33 @@ public:
     }
 };
 
+namespace linalg {
+
+/**
+ * @brief C := A·B, reusing C's buffer when it is large enough
+ * 
+ * EDUCATIONAL NOTE:
+ * C = A * B first builds the product in a new matrix and then moves it
+ * into C, so every iteration of a loop allocates. assign_product writes
+ * straight into C (resizing it only if its capacity is too small), which
+ * makes steady-state loops allocation-free. If C is A or B the product is
+ * formed in a temporary first, since GEMM cannot overwrite its own input.
+ * 
+ * @throws std::invalid_argument if A.get_cols() != B.get_rows()
+ */
+template<typename T>
+void assign_product(Matrix<T>& C, const Matrix<T>& A, const Matrix<T>& B) {
+    if (A.get_cols() != B.get_rows()) {
+        throw std::invalid_argument("Matrix dimensions mismatch for multiplication");
+    }
+    if (&C == &A || &C == &B) {
+        C = A * B;
+        return;
+    }
+    C.resize(A.get_rows(), B.get_cols());
+    C.store_product(A, B);
+}
+
+} // namespace linalg
+
 #endif // MATRIX_HPP
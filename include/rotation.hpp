@@ -0,0 +1,285 @@
+#ifndef ROTATION_HPP
+#define ROTATION_HPP
+
+#include "fixed_matrix.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief Allocation-free 3D rotations: sincos, quaternions and axis-angle
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * A 3D rotation has three degrees of freedom but many representations:
+ *
+ *   Representation   Storage   Composition          Applying to a point
+ *   3x3 matrix       9         27 mul (matrix prod) 9 mul
+ *   Quaternion       4         16 mul (Hamilton)    ~15 mul
+ *   Axis-angle       4         via quaternion       Rodrigues' formula
+ *   Euler angles     3         closed form only     via matrix
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * 1. A unit quaternion q = (cos(θ/2), sin(θ/2)·k) rotates by θ about the
+ *    unit axis k; q and -q describe the same rotation
+ * 2. Quaternions compose cheaply, interpolate smoothly (slerp) and are
+ *    easy to renormalize, so they are the usual state of robot joints,
+ *    IMUs and cameras; matrices are best for transforming many points
+ * 3. Euler angles are convenient for humans but composing them through
+ *    generic matrix products wastes work: the product of three axis
+ *    rotations has a closed form needing only three sin/cos pairs
+ * 4. sin(θ) and cos(θ) share their argument reduction, so computing both
+ *    together (sincos) costs about the same as one of them
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - Everything returns small value types (FixedMatrix, Quaternion): no heap
+ * - Quaternions are stored (w, x, y, z) with w the scalar part
+ * - Functions that require unit quaternions say so; normalized() fixes drift
+ */
+namespace linalg {
+
+/**
+ * @brief sin(angle) and cos(angle) from one evaluation
+ */
+template<typename T>
+struct SinCos {
+    T sin;
+    T cos;
+};
+
+/**
+ * @brief Computes sin and cos of the same angle together
+ *
+ * EDUCATIONAL NOTE:
+ * Both functions first reduce the angle modulo π/2, which is the expensive
+ * part; glibc's sincos() shares that work. Other platforms get two adjacent
+ * calls, which optimizing compilers usually merge in the same way.
+ */
+template<typename T>
+inline SinCos<T> sincos(T angle) {
+#if defined(__GLIBC__) && defined(_GNU_SOURCE)
+    if constexpr (std::is_same_v<T, double>) {
+        SinCos<T> result;
+        ::sincos(angle, &result.sin, &result.cos);
+        return result;
+    } else if constexpr (std::is_same_v<T, float>) {
+        SinCos<T> result;
+        ::sincosf(angle, &result.sin, &result.cos);
+        return result;
+    }
+#endif
+    return {std::sin(angle), std::cos(angle)};
+}
+
+template<typename T>
+class Quaternion {
+public:
+    T w = T(1);
+    T x = T(0);
+    T y = T(0);
+    T z = T(0);
+
+    constexpr Quaternion() = default;
+    constexpr Quaternion(T w_, T x_, T y_, T z_) : w(w_), x(x_), y(y_), z(z_) {}
+
+    static constexpr Quaternion identity() { return Quaternion(); }
+
+    /**
+     * @brief Rotation by angle (radians) about a unit axis
+     */
+    static Quaternion from_axis_angle(const FixedVector<T, 3>& unit_axis, T angle) {
+        const SinCos<T> half = sincos(angle / T(2));
+        return {half.cos, half.sin * unit_axis[0], half.sin * unit_axis[1], half.sin * unit_axis[2]};
+    }
+
+    /**
+     * @brief Roll-pitch-yaw angles, R = Rz(yaw)·Ry(pitch)·Rx(roll)
+     *
+     * EDUCATIONAL NOTE:
+     * Multiplying the three single-axis quaternions symbolically gives each
+     * component as a sum of two products of half-angle sines and cosines:
+     * three sincos calls and 16 multiplications in total.
+     */
+    static Quaternion from_rpy(T roll, T pitch, T yaw) {
+        const SinCos<T> r = sincos(roll / T(2));
+        const SinCos<T> p = sincos(pitch / T(2));
+        const SinCos<T> y = sincos(yaw / T(2));
+        return {r.cos * p.cos * y.cos + r.sin * p.sin * y.sin,
+                r.sin * p.cos * y.cos - r.cos * p.sin * y.sin,
+                r.cos * p.sin * y.cos + r.sin * p.cos * y.sin,
+                r.cos * p.cos * y.sin - r.sin * p.sin * y.cos};
+    }
+
+    /**
+     * @brief Quaternion of a rotation matrix (Shepperd's method)
+     *
+     * EDUCATIONAL NOTE:
+     * The trace gives w directly, but when w is small dividing by it loses
+     * precision. Shepperd's method starts from the largest of w, x, y, z
+     * instead, so no division is ever by a small number.
+     */
+    static Quaternion from_matrix(const FixedMatrix<T, 3, 3>& m) {
+        const T trace = m(0, 0) + m(1, 1) + m(2, 2);
+        Quaternion q;
+        if (trace > m(0, 0) && trace > m(1, 1) && trace > m(2, 2)) {
+            const T s = std::sqrt(T(1) + trace) * T(2);  // s = 4w
+            q = {s / T(4), (m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s};
+        } else if (m(0, 0) >= m(1, 1) && m(0, 0) >= m(2, 2)) {
+            const T s = std::sqrt(T(1) + m(0, 0) - m(1, 1) - m(2, 2)) * T(2);  // s = 4x
+            q = {(m(2, 1) - m(1, 2)) / s, s / T(4), (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s};
+        } else if (m(1, 1) >= m(2, 2)) {
+            const T s = std::sqrt(T(1) + m(1, 1) - m(0, 0) - m(2, 2)) * T(2);  // s = 4y
+            q = {(m(0, 2) - m(2, 0)) / s, (m(0, 1) + m(1, 0)) / s, s / T(4), (m(1, 2) + m(2, 1)) / s};
+        } else {
+            const T s = std::sqrt(T(1) + m(2, 2) - m(0, 0) - m(1, 1)) * T(2);  // s = 4z
+            q = {(m(1, 0) - m(0, 1)) / s, (m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, s / T(4)};
+        }
+        return q.w < T(0) ? -q : q;
+    }
+
+    /**
+     * @brief Rotation matrix of a unit quaternion (no trigonometry)
+     */
+    constexpr FixedMatrix<T, 3, 3> to_matrix() const {
+        const T xx = x * x, yy = y * y, zz = z * z;
+        const T xy = x * y, xz = x * z, yz = y * z;
+        const T wx = w * x, wy = w * y, wz = w * z;
+        return {T(1) - T(2) * (yy + zz), T(2) * (xy - wz),         T(2) * (xz + wy),
+                T(2) * (xy + wz),         T(1) - T(2) * (xx + zz), T(2) * (yz - wx),
+                T(2) * (xz - wy),         T(2) * (yz + wx),         T(1) - T(2) * (xx + yy)};
+    }
+
+    /**
+     * @brief Rotates v by this unit quaternion
+     *
+     * EDUCATIONAL NOTE:
+     * Instead of q·v·q* (two Hamilton products), use
+     *   t = 2 (u × v),  v' = v + w·t + u × t     with u = (x, y, z)
+     * which needs 15 multiplications.
+     */
+    constexpr FixedVector<T, 3> rotate(const FixedVector<T, 3>& v) const {
+        const FixedVector<T, 3> u{x, y, z};
+        const FixedVector<T, 3> t = T(2) * cross(u, v);
+        return v + w * t + cross(u, t);
+    }
+
+    /**
+     * @brief Hamilton product: (p * q) applies q first, then p
+     */
+    constexpr Quaternion operator*(const Quaternion& q) const {
+        return {w * q.w - x * q.x - y * q.y - z * q.z,
+                w * q.x + x * q.w + y * q.z - z * q.y,
+                w * q.y - x * q.z + y * q.w + z * q.x,
+                w * q.z + x * q.y - y * q.x + z * q.w};
+    }
+
+    constexpr Quaternion operator-() const { return {-w, -x, -y, -z}; }
+    constexpr Quaternion conjugate() const { return {w, -x, -y, -z}; }
+    constexpr T dot(const Quaternion& q) const { return w * q.w + x * q.x + y * q.y + z * q.z; }
+    T norm() const { return std::sqrt(dot(*this)); }
+
+    /**
+     * @brief Inverse rotation; equals conjugate() for unit quaternions
+     */
+    constexpr Quaternion inverse() const {
+        const T n2 = dot(*this);
+        return {w / n2, -x / n2, -y / n2, -z / n2};
+    }
+
+    /**
+     * @brief Rescales to unit length, removing drift from repeated products
+     *
+     * @throws std::invalid_argument for the zero quaternion
+     */
+    Quaternion normalized() const {
+        const T n = norm();
+        if (n == T(0)) {
+            throw std::invalid_argument("Cannot normalize a zero quaternion");
+        }
+        return {w / n, x / n, y / n, z / n};
+    }
+
+    /**
+     * @brief Spherical linear interpolation between unit quaternions
+     *
+     * EDUCATIONAL NOTE:
+     * slerp moves at constant angular speed along the shorter arc (q and -q
+     * are the same rotation, so the sign of the dot product picks the arc).
+     * For nearly equal inputs it falls back to normalized linear
+     * interpolation, avoiding division by sin(θ) ≈ 0.
+     */
+    static Quaternion slerp(const Quaternion& a, Quaternion b, T t) {
+        T cos_theta = a.dot(b);
+        if (cos_theta < T(0)) {
+            b = -b;
+            cos_theta = -cos_theta;
+        }
+        if (cos_theta > T(0.9995)) {
+            return Quaternion(a.w + t * (b.w - a.w), a.x + t * (b.x - a.x),
+                              a.y + t * (b.y - a.y), a.z + t * (b.z - a.z)).normalized();
+        }
+        const T theta = std::acos(cos_theta);
+        const T inv_sin = T(1) / std::sin(theta);
+        const T wa = std::sin((T(1) - t) * theta) * inv_sin;
+        const T wb = std::sin(t * theta) * inv_sin;
+        return {wa * a.w + wb * b.w, wa * a.x + wb * b.x, wa * a.y + wb * b.y, wa * a.z + wb * b.z};
+    }
+};
+
+/**
+ * @brief Rotation by angle (radians) about a unit axis
+ */
+template<typename T>
+class AxisAngle {
+public:
+    FixedVector<T, 3> axis{T(1), T(0), T(0)};
+    T angle = T(0);
+
+    AxisAngle() = default;
+
+    /**
+     * @throws std::invalid_argument if axis is the zero vector
+     */
+    AxisAngle(const FixedVector<T, 3>& direction, T radians) : angle(radians) {
+        const T n = norm(direction);
+        if (n == T(0)) {
+            throw std::invalid_argument("Rotation axis must be non-zero");
+        }
+        axis = direction * (T(1) / n);
+    }
+
+    /**
+     * @brief Axis and angle of a unit quaternion (angle in [0, π])
+     */
+    static AxisAngle from_quaternion(const Quaternion<T>& q) {
+        const Quaternion<T> p = q.w < T(0) ? -q : q;
+        const T s = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+        AxisAngle result;
+        result.angle = T(2) * std::atan2(s, p.w);
+        if (s > T(0)) result.axis = FixedVector<T, 3>{p.x / s, p.y / s, p.z / s};
+        return result;
+    }
+
+    Quaternion<T> to_quaternion() const { return Quaternion<T>::from_axis_angle(axis, angle); }
+
+    /**
+     * @brief Rodrigues' formula: R = cos θ·I + sin θ·[k]× + (1 - cos θ)·k·kᵀ
+     */
+    FixedMatrix<T, 3, 3> to_matrix() const {
+        const SinCos<T> sc = sincos(angle);
+        const T c1 = T(1) - sc.cos;
+        const T kx = axis[0], ky = axis[1], kz = axis[2];
+        return {sc.cos + c1 * kx * kx,     c1 * kx * ky - sc.sin * kz, c1 * kx * kz + sc.sin * ky,
+                c1 * ky * kx + sc.sin * kz, sc.cos + c1 * ky * ky,     c1 * ky * kz - sc.sin * kx,
+                c1 * kz * kx - sc.sin * ky, c1 * kz * ky + sc.sin * kx, sc.cos + c1 * kz * kz};
+    }
+};
+
+using Quaterniond = Quaternion<double>;
+using Quaternionf = Quaternion<float>;
+
+} // namespace linalg
+
+#endif // ROTATION_HPP
@@ -0,0 +1,905 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define LINALG_SIMD_X86 1
+#include <immintrin.h>
+#define LINALG_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define LINALG_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#define LINALG_INLINE_AVX2 inline __attribute__((always_inline, target("avx2,fma")))
+#define LINALG_INLINE_AVX512 inline __attribute__((always_inline, target("avx512f,avx2,fma")))
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define LINALG_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Hints for loops left to the auto-vectorizer: the iterations of the next
+// loop are independent, and a helper must be inlined into its (possibly
+// target-specific) caller so that it is compiled for the caller's ISA
+#if defined(__clang__)
+#define LINALG_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#define LINALG_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif defined(__GNUC__)
+#define LINALG_IVDEP _Pragma("GCC ivdep")
+#define LINALG_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define LINALG_IVDEP
+#define LINALG_ALWAYS_INLINE inline
+#endif
+
+/**
+ * @brief SIMD kernel layer with run-time CPU dispatch
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * SIMD (Single Instruction, Multiple Data) instructions operate on several
+ * numbers at once: an AVX2 register holds 4 doubles, an AVX-512 register 8.
+ * Fused multiply-add (FMA) computes a*b + c in a single instruction, which
+ * doubles the peak flop rate of the inner loops of GEMM, dot and axpy.
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * 1. Function multiversioning: each kernel is compiled several times with
+ *    different target attributes, so one binary contains AVX2, AVX-512 and
+ *    portable versions without requiring -mavx2 on the command line
+ * 2. Run-time dispatch: the CPU is queried once (cpuid) and a table of
+ *    function pointers is filled with the best kernels it supports
+ * 3. Multiple accumulators: reductions such as dot keep several partial
+ *    sums in flight to hide FMA latency
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - kernels<T>() returns the table for the active ISA (float and double)
+ * - The LINALG_SIMD environment variable (scalar, avx2, avx512, neon) can
+ *   lower the selected level, e.g. to compare paths while debugging
+ * - On AArch64, NEON is part of the baseline ISA and needs no detection
+ */
+namespace linalg {
+
+namespace detail {
+
+/**
+ * @brief GEMM micro-kernel signature
+ *
+ * Computes C(0:MR, 0:NR) += alpha * Apack * Bpack where Apack holds kc groups
+ * of MR values and Bpack holds kc groups of NR values. C is row-major with
+ * leading dimension ldc. With accumulate == false C is overwritten instead
+ * and never read, so the first k panel of a beta == 0 product needs no
+ * zero-filled C.
+ */
+template<typename T>
+using micro_kernel_fn = void (*)(size_t kc, T alpha, const T* a, const T* b, T* c, size_t ldc,
+                                 bool accumulate);
+
+template<typename T>
+struct micro_kernel {
+    size_t mr;
+    size_t nr;
+    micro_kernel_fn<T> fn;
+};
+
+/**
+ * @brief Portable register-tiled micro-kernel
+ *
+ * The accumulator array has compile-time extents, so the compiler keeps it
+ * in registers and unrolls (and usually vectorizes) the inner loops.
+ */
+template<typename T, size_t MR, size_t NR>
+void micro_kernel_generic(size_t kc, T alpha, const T* a, const T* b, T* c, size_t ldc,
+                          bool accumulate) {
+    T acc[MR][NR] = {};
+    for (size_t p = 0; p < kc; ++p) {
+        for (size_t i = 0; i < MR; ++i) {
+            const T ai = a[i];
+            for (size_t j = 0; j < NR; ++j) {
+                acc[i][j] += ai * b[j];
+            }
+        }
+        a += MR;
+        b += NR;
+    }
+    for (size_t i = 0; i < MR; ++i) {
+        for (size_t j = 0; j < NR; ++j) {
+            c[i * ldc + j] = accumulate ? c[i * ldc + j] + alpha * acc[i][j] : alpha * acc[i][j];
+        }
+    }
+}
+
+} // namespace detail
+
+namespace simd {
+
+/**
+ * @brief Instruction set levels known to the dispatcher, lowest first
+ */
+enum class isa { scalar, avx2, avx512, neon };
+
+inline const char* isa_name(isa level) {
+    switch (level) {
+        case isa::avx2: return "avx2";
+        case isa::avx512: return "avx512";
+        case isa::neon: return "neon";
+        default: return "scalar";
+    }
+}
+
+/**
+ * @brief Whether element type T has hand-written kernels
+ */
+template<typename T>
+constexpr bool has_kernels = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/**
+ * @brief Function table for one element type and one ISA level
+ */
+template<typename T>
+struct kernel_table {
+    isa level;
+    detail::micro_kernel<T> gemm;
+    T (*dot)(size_t n, const T* x, const T* y);
+    void (*axpy)(size_t n, T alpha, const T* x, T* y);           // y += alpha * x
+    void (*axpby)(size_t n, T alpha, const T* x, T beta, T* y);  // y = alpha * x + beta * y
+    void (*scal)(size_t n, T alpha, T* x);                       // x *= alpha
+};
+
+// ---------------------------------------------------------------------------
+// Portable kernels
+// ---------------------------------------------------------------------------
+
+template<typename T>
+T dot_generic(size_t n, const T* x, const T* y) {
+    T s0 = T(), s1 = T(), s2 = T(), s3 = T();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += x[i] * y[i];
+        s1 += x[i + 1] * y[i + 1];
+        s2 += x[i + 2] * y[i + 2];
+        s3 += x[i + 3] * y[i + 3];
+    }
+    for (; i < n; ++i) {
+        s0 += x[i] * y[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+template<typename T>
+void axpy_generic(size_t n, T alpha, const T* x, T* y) {
+    for (size_t i = 0; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+template<typename T>
+void axpby_generic(size_t n, T alpha, const T* x, T beta, T* y) {
+    for (size_t i = 0; i < n; ++i) {
+        y[i] = alpha * x[i] + beta * y[i];
+    }
+}
+
+template<typename T>
+void scal_generic(size_t n, T alpha, T* x) {
+    for (size_t i = 0; i < n; ++i) {
+        x[i] *= alpha;
+    }
+}
+
+#if defined(LINALG_SIMD_X86)
+
+// ---------------------------------------------------------------------------
+// AVX2 + FMA kernels (Haswell and later, Zen)
+// ---------------------------------------------------------------------------
+
+LINALG_INLINE_AVX2 double hsum_avx2(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    const __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+LINALG_INLINE_AVX2 float hsum_avx2(__m256 v) {
+    __m128 lo = _mm256_castps256_ps128(v);
+    const __m128 hi = _mm256_extractf128_ps(v, 1);
+    lo = _mm_add_ps(lo, hi);
+    lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+    return _mm_cvtss_f32(_mm_add_ss(lo, _mm_movehdup_ps(lo)));
+}
+
+// C row (8 doubles) += alpha * (acc0, acc1), or = when not accumulating
+LINALG_INLINE_AVX2 void update_row_avx2(double* c, __m256d va, __m256d acc0, __m256d acc1,
+                                        bool accumulate) {
+    if (accumulate) {
+        _mm256_storeu_pd(c, _mm256_fmadd_pd(va, acc0, _mm256_loadu_pd(c)));
+        _mm256_storeu_pd(c + 4, _mm256_fmadd_pd(va, acc1, _mm256_loadu_pd(c + 4)));
+    } else {
+        _mm256_storeu_pd(c, _mm256_mul_pd(va, acc0));
+        _mm256_storeu_pd(c + 4, _mm256_mul_pd(va, acc1));
+    }
+}
+
+// C row (16 floats) += alpha * (acc0, acc1), or = when not accumulating
+LINALG_INLINE_AVX2 void update_row_avx2(float* c, __m256 va, __m256 acc0, __m256 acc1,
+                                        bool accumulate) {
+    if (accumulate) {
+        _mm256_storeu_ps(c, _mm256_fmadd_ps(va, acc0, _mm256_loadu_ps(c)));
+        _mm256_storeu_ps(c + 8, _mm256_fmadd_ps(va, acc1, _mm256_loadu_ps(c + 8)));
+    } else {
+        _mm256_storeu_ps(c, _mm256_mul_ps(va, acc0));
+        _mm256_storeu_ps(c + 8, _mm256_mul_ps(va, acc1));
+    }
+}
+
+/**
+ * @brief 6x8 double micro-kernel: 12 accumulators, 2 B loads and 6
+ * broadcasts per k step (15 of the 16 ymm registers)
+ */
+LINALG_TARGET_AVX2 inline void gemm_avx2_6x8(size_t kc, double alpha, const double* a,
+                                            const double* b, double* c, size_t ldc,
+                                            bool accumulate) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+    for (size_t p = 0; p < kc; ++p) {
+        const __m256d b0 = _mm256_loadu_pd(b);
+        const __m256d b1 = _mm256_loadu_pd(b + 4);
+        __m256d ai = _mm256_broadcast_sd(a);
+        c00 = _mm256_fmadd_pd(ai, b0, c00); c01 = _mm256_fmadd_pd(ai, b1, c01);
+        ai = _mm256_broadcast_sd(a + 1);
+        c10 = _mm256_fmadd_pd(ai, b0, c10); c11 = _mm256_fmadd_pd(ai, b1, c11);
+        ai = _mm256_broadcast_sd(a + 2);
+        c20 = _mm256_fmadd_pd(ai, b0, c20); c21 = _mm256_fmadd_pd(ai, b1, c21);
+        ai = _mm256_broadcast_sd(a + 3);
+        c30 = _mm256_fmadd_pd(ai, b0, c30); c31 = _mm256_fmadd_pd(ai, b1, c31);
+        ai = _mm256_broadcast_sd(a + 4);
+        c40 = _mm256_fmadd_pd(ai, b0, c40); c41 = _mm256_fmadd_pd(ai, b1, c41);
+        ai = _mm256_broadcast_sd(a + 5);
+        c50 = _mm256_fmadd_pd(ai, b0, c50); c51 = _mm256_fmadd_pd(ai, b1, c51);
+        a += 6;
+        b += 8;
+    }
+    const __m256d va = _mm256_set1_pd(alpha);
+    update_row_avx2(c, va, c00, c01, accumulate);
+    update_row_avx2(c + ldc, va, c10, c11, accumulate);
+    update_row_avx2(c + 2 * ldc, va, c20, c21, accumulate);
+    update_row_avx2(c + 3 * ldc, va, c30, c31, accumulate);
+    update_row_avx2(c + 4 * ldc, va, c40, c41, accumulate);
+    update_row_avx2(c + 5 * ldc, va, c50, c51, accumulate);
+}
+
+/**
+ * @brief 6x16 float micro-kernel (same register budget as the double one)
+ */
+LINALG_TARGET_AVX2 inline void gemm_avx2_6x16(size_t kc, float alpha, const float* a,
+                                             const float* b, float* c, size_t ldc,
+                                             bool accumulate) {
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+    for (size_t p = 0; p < kc; ++p) {
+        const __m256 b0 = _mm256_loadu_ps(b);
+        const __m256 b1 = _mm256_loadu_ps(b + 8);
+        __m256 ai = _mm256_broadcast_ss(a);
+        c00 = _mm256_fmadd_ps(ai, b0, c00); c01 = _mm256_fmadd_ps(ai, b1, c01);
+        ai = _mm256_broadcast_ss(a + 1);
+        c10 = _mm256_fmadd_ps(ai, b0, c10); c11 = _mm256_fmadd_ps(ai, b1, c11);
+        ai = _mm256_broadcast_ss(a + 2);
+        c20 = _mm256_fmadd_ps(ai, b0, c20); c21 = _mm256_fmadd_ps(ai, b1, c21);
+        ai = _mm256_broadcast_ss(a + 3);
+        c30 = _mm256_fmadd_ps(ai, b0, c30); c31 = _mm256_fmadd_ps(ai, b1, c31);
+        ai = _mm256_broadcast_ss(a + 4);
+        c40 = _mm256_fmadd_ps(ai, b0, c40); c41 = _mm256_fmadd_ps(ai, b1, c41);
+        ai = _mm256_broadcast_ss(a + 5);
+        c50 = _mm256_fmadd_ps(ai, b0, c50); c51 = _mm256_fmadd_ps(ai, b1, c51);
+        a += 6;
+        b += 16;
+    }
+    const __m256 va = _mm256_set1_ps(alpha);
+    update_row_avx2(c, va, c00, c01, accumulate);
+    update_row_avx2(c + ldc, va, c10, c11, accumulate);
+    update_row_avx2(c + 2 * ldc, va, c20, c21, accumulate);
+    update_row_avx2(c + 3 * ldc, va, c30, c31, accumulate);
+    update_row_avx2(c + 4 * ldc, va, c40, c41, accumulate);
+    update_row_avx2(c + 5 * ldc, va, c50, c51, accumulate);
+}
+
+LINALG_TARGET_AVX2 inline double dot_avx2(size_t n, const double* x, const double* y) {
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), s1);
+        s2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8), _mm256_loadu_pd(y + i + 8), s2);
+        s3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12), s3);
+    }
+    for (; i + 4 <= n; i += 4) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+    }
+    double sum = hsum_avx2(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    for (; i < n; ++i) {
+        sum += x[i] * y[i];
+    }
+    return sum;
+}
+
+LINALG_TARGET_AVX2 inline float dot_avx2(size_t n, const float* x, const float* y) {
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+    __m256 s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), s0);
+        s1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), s1);
+        s2 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 16), _mm256_loadu_ps(y + i + 16), s2);
+        s3 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 24), _mm256_loadu_ps(y + i + 24), s3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), s0);
+    }
+    float sum = hsum_avx2(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+    for (; i < n; ++i) {
+        sum += x[i] * y[i];
+    }
+    return sum;
+}
+
+LINALG_TARGET_AVX2 inline void axpy_avx2(size_t n, double alpha, const double* x, double* y) {
+    const __m256d va = _mm256_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        _mm256_storeu_pd(y + i + 4, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+    }
+    for (; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+LINALG_TARGET_AVX2 inline void axpy_avx2(size_t n, float alpha, const float* x, float* y) {
+    const __m256 va = _mm256_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+        _mm256_storeu_ps(y + i + 8, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8)));
+    }
+    for (; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+LINALG_TARGET_AVX2 inline void axpby_avx2(size_t n, double alpha, const double* x, double beta, double* y) {
+    const __m256d va = _mm256_set1_pd(alpha);
+    const __m256d vb = _mm256_set1_pd(beta);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d by = _mm256_mul_pd(vb, _mm256_loadu_pd(y + i));
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), by));
+    }
+    for (; i < n; ++i) {
+        y[i] = alpha * x[i] + beta * y[i];
+    }
+}
+
+LINALG_TARGET_AVX2 inline void axpby_avx2(size_t n, float alpha, const float* x, float beta, float* y) {
+    const __m256 va = _mm256_set1_ps(alpha);
+    const __m256 vb = _mm256_set1_ps(beta);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 by = _mm256_mul_ps(vb, _mm256_loadu_ps(y + i));
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), by));
+    }
+    for (; i < n; ++i) {
+        y[i] = alpha * x[i] + beta * y[i];
+    }
+}
+
+LINALG_TARGET_AVX2 inline void scal_avx2(size_t n, double alpha, double* x) {
+    const __m256d va = _mm256_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(x + i, _mm256_mul_pd(va, _mm256_loadu_pd(x + i)));
+    }
+    for (; i < n; ++i) {
+        x[i] *= alpha;
+    }
+}
+
+LINALG_TARGET_AVX2 inline void scal_avx2(size_t n, float alpha, float* x) {
+    const __m256 va = _mm256_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(x + i, _mm256_mul_ps(va, _mm256_loadu_ps(x + i)));
+    }
+    for (; i < n; ++i) {
+        x[i] *= alpha;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512F kernels (Skylake-X, Ice Lake, Zen 4)
+// ---------------------------------------------------------------------------
+
+// Horizontal sums via the 256-bit halves (GCC 12's _mm512_reduce_add_*
+// trips -Wuninitialized inside its own header)
+LINALG_INLINE_AVX512 double hsum_avx512(__m512d v) {
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, v);
+    return hsum_avx2(_mm256_add_pd(_mm256_load_pd(lanes), _mm256_load_pd(lanes + 4)));
+}
+
+LINALG_INLINE_AVX512 float hsum_avx512(__m512 v) {
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, v);
+    return hsum_avx2(_mm256_add_ps(_mm256_load_ps(lanes), _mm256_load_ps(lanes + 8)));
+}
+
+/**
+ * @brief 8x16 double micro-kernel: 16 zmm accumulators
+ */
+LINALG_TARGET_AVX512 inline void gemm_avx512_8x16(size_t kc, double alpha, const double* a,
+                                                 const double* b, double* c, size_t ldc,
+                                                 bool accumulate) {
+    __m512d acc[8][2];
+    for (int i = 0; i < 8; ++i) {
+        acc[i][0] = _mm512_setzero_pd();
+        acc[i][1] = _mm512_setzero_pd();
+    }
+    for (size_t p = 0; p < kc; ++p) {
+        const __m512d b0 = _mm512_loadu_pd(b);
+        const __m512d b1 = _mm512_loadu_pd(b + 8);
+#pragma GCC unroll 8
+        for (int i = 0; i < 8; ++i) {
+            const __m512d ai = _mm512_set1_pd(a[i]);
+            acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+        }
+        a += 8;
+        b += 16;
+    }
+    const __m512d va = _mm512_set1_pd(alpha);
+#pragma GCC unroll 8
+    for (int i = 0; i < 8; ++i) {
+        double* row = c + i * ldc;
+        if (accumulate) {
+            _mm512_storeu_pd(row, _mm512_fmadd_pd(va, acc[i][0], _mm512_loadu_pd(row)));
+            _mm512_storeu_pd(row + 8, _mm512_fmadd_pd(va, acc[i][1], _mm512_loadu_pd(row + 8)));
+        } else {
+            _mm512_storeu_pd(row, _mm512_mul_pd(va, acc[i][0]));
+            _mm512_storeu_pd(row + 8, _mm512_mul_pd(va, acc[i][1]));
+        }
+    }
+}
+
+/**
+ * @brief 8x32 float micro-kernel: 16 zmm accumulators
+ */
+LINALG_TARGET_AVX512 inline void gemm_avx512_8x32(size_t kc, float alpha, const float* a,
+                                                 const float* b, float* c, size_t ldc,
+                                                 bool accumulate) {
+    __m512 acc[8][2];
+    for (int i = 0; i < 8; ++i) {
+        acc[i][0] = _mm512_setzero_ps();
+        acc[i][1] = _mm512_setzero_ps();
+    }
+    for (size_t p = 0; p < kc; ++p) {
+        const __m512 b0 = _mm512_loadu_ps(b);
+        const __m512 b1 = _mm512_loadu_ps(b + 16);
+#pragma GCC unroll 8
+        for (int i = 0; i < 8; ++i) {
+            const __m512 ai = _mm512_set1_ps(a[i]);
+            acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+        }
+        a += 8;
+        b += 32;
+    }
+    const __m512 va = _mm512_set1_ps(alpha);
+#pragma GCC unroll 8
+    for (int i = 0; i < 8; ++i) {
+        float* row = c + i * ldc;
+        if (accumulate) {
+            _mm512_storeu_ps(row, _mm512_fmadd_ps(va, acc[i][0], _mm512_loadu_ps(row)));
+            _mm512_storeu_ps(row + 16, _mm512_fmadd_ps(va, acc[i][1], _mm512_loadu_ps(row + 16)));
+        } else {
+            _mm512_storeu_ps(row, _mm512_mul_ps(va, acc[i][0]));
+            _mm512_storeu_ps(row + 16, _mm512_mul_ps(va, acc[i][1]));
+        }
+    }
+}
+
+LINALG_TARGET_AVX512 inline double dot_avx512(size_t n, const double* x, const double* y) {
+    __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+    __m512d s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), s0);
+        s1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), s1);
+        s2 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 16), _mm512_loadu_pd(y + i + 16), s2);
+        s3 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 24), _mm512_loadu_pd(y + i + 24), s3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        s0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), s0);
+    }
+    if (i < n) {
+        const __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        s1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(m, x + i), _mm512_maskz_loadu_pd(m, y + i), s1);
+    }
+    return hsum_avx512(_mm512_add_pd(_mm512_add_pd(s0, s1), _mm512_add_pd(s2, s3)));
+}
+
+LINALG_TARGET_AVX512 inline float dot_avx512(size_t n, const float* x, const float* y) {
+    __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+    __m512 s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        s0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), s0);
+        s1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), s1);
+        s2 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 32), _mm512_loadu_ps(y + i + 32), s2);
+        s3 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 48), _mm512_loadu_ps(y + i + 48), s3);
+    }
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), s0);
+    }
+    if (i < n) {
+        const __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        s1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, x + i), _mm512_maskz_loadu_ps(m, y + i), s1);
+    }
+    return hsum_avx512(_mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3)));
+}
+
+LINALG_TARGET_AVX512 inline void axpy_avx512(size_t n, double alpha, const double* x, double* y) {
+    const __m512d va = _mm512_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+    }
+    if (i < n) {
+        const __mmask8 m = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(y + i, m, _mm512_fmadd_pd(va, _mm512_maskz_loadu_pd(m, x + i),
+                                                        _mm512_maskz_loadu_pd(m, y + i)));
+    }
+}
+
+LINALG_TARGET_AVX512 inline void axpy_avx512(size_t n, float alpha, const float* x, float* y) {
+    const __m512 va = _mm512_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+    }
+    if (i < n) {
+        const __mmask16 m = static_cast<__mmask16>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_ps(y + i, m, _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(m, x + i),
+                                                        _mm512_maskz_loadu_ps(m, y + i)));
+    }
+}
+
+LINALG_TARGET_AVX512 inline void axpby_avx512(size_t n, double alpha, const double* x, double beta, double* y) {
+    const __m512d va = _mm512_set1_pd(alpha);
+    const __m512d vb = _mm512_set1_pd(beta);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m512d by = _mm512_mul_pd(vb, _mm512_loadu_pd(y + i));
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), by));
+    }
+    for (; i < n; ++i) {
+        y[i] = alpha * x[i] + beta * y[i];
+    }
+}
+
+LINALG_TARGET_AVX512 inline void axpby_avx512(size_t n, float alpha, const float* x, float beta, float* y) {
+    const __m512 va = _mm512_set1_ps(alpha);
+    const __m512 vb = _mm512_set1_ps(beta);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512 by = _mm512_mul_ps(vb, _mm512_loadu_ps(y + i));
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i), by));
+    }
+    for (; i < n; ++i) {
+        y[i] = alpha * x[i] + beta * y[i];
+    }
+}
+
+LINALG_TARGET_AVX512 inline void scal_avx512(size_t n, double alpha, double* x) {
+    const __m512d va = _mm512_set1_pd(alpha);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(x + i, _mm512_mul_pd(va, _mm512_loadu_pd(x + i)));
+    }
+    for (; i < n; ++i) {
+        x[i] *= alpha;
+    }
+}
+
+LINALG_TARGET_AVX512 inline void scal_avx512(size_t n, float alpha, float* x) {
+    const __m512 va = _mm512_set1_ps(alpha);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(x + i, _mm512_mul_ps(va, _mm512_loadu_ps(x + i)));
+    }
+    for (; i < n; ++i) {
+        x[i] *= alpha;
+    }
+}
+
+#endif // LINALG_SIMD_X86
+
+#if defined(LINALG_SIMD_NEON)
+
+// ---------------------------------------------------------------------------
+// NEON kernels (AArch64 baseline: 32 x 128-bit registers)
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief 4x8 double micro-kernel: 16 q-register accumulators
+ */
+inline void gemm_neon_4x8(size_t kc, double alpha, const double* a,
+                          const double* b, double* c, size_t ldc,
+                          bool accumulate) {
+    float64x2_t acc[4][4];
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            acc[i][j] = vdupq_n_f64(0.0);
+    for (size_t p = 0; p < kc; ++p) {
+        const float64x2_t b0 = vld1q_f64(b), b1 = vld1q_f64(b + 2);
+        const float64x2_t b2 = vld1q_f64(b + 4), b3 = vld1q_f64(b + 6);
+        for (int i = 0; i < 4; ++i) {
+            acc[i][0] = vfmaq_n_f64(acc[i][0], b0, a[i]);
+            acc[i][1] = vfmaq_n_f64(acc[i][1], b1, a[i]);
+            acc[i][2] = vfmaq_n_f64(acc[i][2], b2, a[i]);
+            acc[i][3] = vfmaq_n_f64(acc[i][3], b3, a[i]);
+        }
+        a += 4;
+        b += 8;
+    }
+    for (int i = 0; i < 4; ++i) {
+        double* row = c + i * ldc;
+        for (int j = 0; j < 4; ++j) {
+            const float64x2_t base = accumulate ? vld1q_f64(row + 2 * j) : vdupq_n_f64(0.0);
+            vst1q_f64(row + 2 * j, vfmaq_n_f64(base, acc[i][j], alpha));
+        }
+    }
+}
+
+/**
+ * @brief 8x8 float micro-kernel: 16 q-register accumulators
+ */
+inline void gemm_neon_8x8(size_t kc, float alpha, const float* a,
+                          const float* b, float* c, size_t ldc,
+                          bool accumulate) {
+    float32x4_t acc[8][2];
+    for (int i = 0; i < 8; ++i) {
+        acc[i][0] = vdupq_n_f32(0.0f);
+        acc[i][1] = vdupq_n_f32(0.0f);
+    }
+    for (size_t p = 0; p < kc; ++p) {
+        const float32x4_t b0 = vld1q_f32(b), b1 = vld1q_f32(b + 4);
+        for (int i = 0; i < 8; ++i) {
+            acc[i][0] = vfmaq_n_f32(acc[i][0], b0, a[i]);
+            acc[i][1] = vfmaq_n_f32(acc[i][1], b1, a[i]);
+        }
+        a += 8;
+        b += 8;
+    }
+    for (int i = 0; i < 8; ++i) {
+        float* row = c + i * ldc;
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        vst1q_f32(row, vfmaq_n_f32(accumulate ? vld1q_f32(row) : zero, acc[i][0], alpha));
+        vst1q_f32(row + 4, vfmaq_n_f32(accumulate ? vld1q_f32(row + 4) : zero, acc[i][1], alpha));
+    }
+}
+
+inline double dot_neon(size_t n, const double* x, const double* y) {
+    float64x2_t s0 = vdupq_n_f64(0.0), s1 = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 = vfmaq_f64(s0, vld1q_f64(x + i), vld1q_f64(y + i));
+        s1 = vfmaq_f64(s1, vld1q_f64(x + i + 2), vld1q_f64(y + i + 2));
+    }
+    double sum = vaddvq_f64(vaddq_f64(s0, s1));
+    for (; i < n; ++i) {
+        sum += x[i] * y[i];
+    }
+    return sum;
+}
+
+inline float dot_neon(size_t n, const float* x, const float* y) {
+    float32x4_t s0 = vdupq_n_f32(0.0f), s1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        s0 = vfmaq_f32(s0, vld1q_f32(x + i), vld1q_f32(y + i));
+        s1 = vfmaq_f32(s1, vld1q_f32(x + i + 4), vld1q_f32(y + i + 4));
+    }
+    float sum = vaddvq_f32(vaddq_f32(s0, s1));
+    for (; i < n; ++i) {
+        sum += x[i] * y[i];
+    }
+    return sum;
+}
+
+inline void axpy_neon(size_t n, double alpha, const double* x, double* y) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        vst1q_f64(y + i, vfmaq_n_f64(vld1q_f64(y + i), vld1q_f64(x + i), alpha));
+    }
+    for (; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+inline void axpy_neon(size_t n, float alpha, const float* x, float* y) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(y + i, vfmaq_n_f32(vld1q_f32(y + i), vld1q_f32(x + i), alpha));
+    }
+    for (; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+#endif // LINALG_SIMD_NEON
+
+// ---------------------------------------------------------------------------
+// Dispatch
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Highest ISA level the running CPU (and OS) supports
+ */
+inline isa detect_isa() {
+#if defined(LINALG_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return isa::avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return isa::avx2;
+    return isa::scalar;
+#elif defined(LINALG_SIMD_NEON)
+    return isa::neon;
+#else
+    return isa::scalar;
+#endif
+}
+
+/**
+ * @brief Whether kernels for the given level can run on this machine
+ */
+inline bool isa_supported(isa level) {
+    if (level == isa::scalar) return true;
+    const isa best = detect_isa();
+    if (best == isa::neon || level == isa::neon) return level == best;
+    return static_cast<int>(level) <= static_cast<int>(best);
+}
+
+/**
+ * @brief ISA level used by kernels<T>(), chosen once per process
+ */
+inline isa active_isa() {
+    static const isa level = [] {
+        isa chosen = detect_isa();
+        if (const char* env = std::getenv("LINALG_SIMD")) {
+            for (isa candidate : {isa::scalar, isa::avx2, isa::avx512, isa::neon}) {
+                if (std::strcmp(env, isa_name(candidate)) == 0 && isa_supported(candidate)) {
+                    chosen = candidate;
+                }
+            }
+        }
+        return chosen;
+    }();
+    return level;
+}
+
+/**
+ * @brief Kernel table for a specific ISA level
+ *
+ * Levels the CPU cannot run (or that were not compiled in) fall back to the
+ * portable kernels; use isa_supported() before calling these on purpose.
+ */
+template<typename T>
+kernel_table<T> kernels_for(isa level) {
+    static_assert(has_kernels<T>, "SIMD kernels exist for float and double only");
+    kernel_table<T> table{isa::scalar,
+                          {4, 8, &detail::micro_kernel_generic<T, 4, 8>},
+                          &dot_generic<T>, &axpy_generic<T>, &axpby_generic<T>, &scal_generic<T>};
+    if (!isa_supported(level)) return table;
+#if defined(LINALG_SIMD_X86)
+    if (level == isa::avx2) {
+        table.level = isa::avx2;
+        if constexpr (std::is_same_v<T, double>) {
+            table.gemm = {6, 8, &gemm_avx2_6x8};
+        } else {
+            table.gemm = {6, 16, &gemm_avx2_6x16};
+        }
+        table.dot = static_cast<T (*)(size_t, const T*, const T*)>(&dot_avx2);
+        table.axpy = static_cast<void (*)(size_t, T, const T*, T*)>(&axpy_avx2);
+        table.axpby = static_cast<void (*)(size_t, T, const T*, T, T*)>(&axpby_avx2);
+        table.scal = static_cast<void (*)(size_t, T, T*)>(&scal_avx2);
+    } else if (level == isa::avx512) {
+        table.level = isa::avx512;
+        if constexpr (std::is_same_v<T, double>) {
+            table.gemm = {8, 16, &gemm_avx512_8x16};
+        } else {
+            table.gemm = {8, 32, &gemm_avx512_8x32};
+        }
+        table.dot = static_cast<T (*)(size_t, const T*, const T*)>(&dot_avx512);
+        table.axpy = static_cast<void (*)(size_t, T, const T*, T*)>(&axpy_avx512);
+        table.axpby = static_cast<void (*)(size_t, T, const T*, T, T*)>(&axpby_avx512);
+        table.scal = static_cast<void (*)(size_t, T, T*)>(&scal_avx512);
+    }
+#elif defined(LINALG_SIMD_NEON)
+    if (level == isa::neon) {
+        table.level = isa::neon;
+        if constexpr (std::is_same_v<T, double>) {
+            table.gemm = {4, 8, &gemm_neon_4x8};
+        } else {
+            table.gemm = {8, 8, &gemm_neon_8x8};
+        }
+        table.dot = static_cast<T (*)(size_t, const T*, const T*)>(&dot_neon);
+        table.axpy = static_cast<void (*)(size_t, T, const T*, T*)>(&axpy_neon);
+    }
+#endif
+    return table;
+}
+
+/**
+ * @brief Kernel table for the active ISA (initialized on first use)
+ */
+template<typename T>
+const kernel_table<T>& kernels() {
+    static const kernel_table<T> table = kernels_for<T>(active_isa());
+    return table;
+}
+
+/**
+ * @brief Type-generic entry points
+ *
+ * float and double go through the dispatched table; any other element type
+ * uses the portable loops. Higher-level routines call these so they need no
+ * per-type special cases.
+ */
+template<typename T>
+T dot(size_t n, const T* x, const T* y) {
+    if constexpr (has_kernels<T>) {
+        return kernels<T>().dot(n, x, y);
+    } else {
+        return dot_generic(n, x, y);
+    }
+}
+
+template<typename T>
+void axpy(size_t n, T alpha, const T* x, T* y) {
+    if constexpr (has_kernels<T>) {
+        kernels<T>().axpy(n, alpha, x, y);
+    } else {
+        axpy_generic(n, alpha, x, y);
+    }
+}
+
+template<typename T>
+void axpby(size_t n, T alpha, const T* x, T beta, T* y) {
+    if constexpr (has_kernels<T>) {
+        kernels<T>().axpby(n, alpha, x, beta, y);
+    } else {
+        axpby_generic(n, alpha, x, beta, y);
+    }
+}
+
+template<typename T>
+void scal(size_t n, T alpha, T* x) {
+    if constexpr (has_kernels<T>) {
+        kernels<T>().scal(n, alpha, x);
+    } else {
+        scal_generic(n, alpha, x);
+    }
+}
+
+} // namespace simd
+} // namespace linalg
+
+#endif // SIMD_HPP
@@ -0,0 +1,98 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+/**
+ * @brief Non-owning view of a contiguous range of elements
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * A span is a (pointer, length) pair: it lets a function accept "some
+ * contiguous elements" without caring whether they live in a Matrix row, a
+ * Vector, a std::vector or a C array, and without copying them.
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * 1. Non-owning: the viewed object must outlive the span
+ * 2. Cheap to pass by value (two machine words)
+ * 3. Span<const T> is a read-only view; Span<T> converts to it implicitly
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - Under C++20, linalg::Span<T> is exactly std::span<T>
+ * - Under C++17 it is a minimal class with the same member names (data,
+ *   size, empty, operator[], begin/end, first, last, subspan), so code
+ *   written against it compiles unchanged with either standard
+ */
+namespace linalg {
+
+#if defined(__cpp_lib_span)
+
+template<typename T>
+using Span = std::span<T>;
+
+#else
+
+template<typename T>
+class Span {
+private:
+    T* ptr = nullptr;
+    size_t count = 0;
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* first, size_t size) noexcept : ptr(first), count(size) {}
+
+    // Span<T> -> Span<const T>
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept : ptr(other.data()), count(other.size()) {}
+
+    constexpr T* data() const noexcept { return ptr; }
+    constexpr size_t size() const noexcept { return count; }
+    constexpr size_t size_bytes() const noexcept { return count * sizeof(T); }
+    constexpr bool empty() const noexcept { return count == 0; }
+
+    // Unchecked, like std::span (asserted in debug builds)
+    constexpr T& operator[](size_t i) const {
+        assert(i < count);
+        return ptr[i];
+    }
+    constexpr T& front() const { return (*this)[0]; }
+    constexpr T& back() const { return (*this)[count - 1]; }
+
+    constexpr T* begin() const noexcept { return ptr; }
+    constexpr T* end() const noexcept { return ptr + count; }
+
+    constexpr Span first(size_t n) const {
+        assert(n <= count);
+        return Span(ptr, n);
+    }
+    constexpr Span last(size_t n) const {
+        assert(n <= count);
+        return Span(ptr + count - n, n);
+    }
+    constexpr Span subspan(size_t offset, size_t n = size_t(-1)) const {
+        assert(offset <= count);
+        return Span(ptr + offset, n == size_t(-1) ? count - offset : n);
+    }
+};
+
+#endif
+
+} // namespace linalg
+
+#endif // SPAN_HPP
@@ -0,0 +1,567 @@
+#ifndef SPARSE_HPP
+#define SPARSE_HPP
+
+#include "matrix.hpp"
+#include "vector.hpp"
+#include "gemv.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Compressed sparse matrices (CSR / CSC)
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Finite-element, finite-difference and graph matrices have a handful of
+ * nonzeros per row. Stored densely, a 10⁶ x 10⁶ matrix needs 8 TB; stored
+ * compressed it needs memory proportional to its nonzeros (nnz).
+ *
+ * Compressed sparse row (CSR) keeps three arrays:
+ *
+ *   A = [5 0 0 1]      offsets = [0 2 3 5]       row i is entries
+ *       [0 2 0 0]      indices = [0 3 1 0 2]     offsets[i] .. offsets[i+1]
+ *       [3 0 4 0]      values  = [5 1 2 3 4]
+ *
+ * Compressed sparse column (CSC) is the same with rows and columns
+ * exchanged, so the CSC arrays of A are exactly the CSR arrays of Aᵀ.
+ * The format decides which products are natural:
+ *
+ *   y = A·x on CSR     y[i] is a sparse dot product of row i with x
+ *                      -> rows are independent, split rows across threads
+ *   y = A·x on CSC     y += x[j] · (column j), a scatter
+ *                      -> writes collide, runs on one thread
+ *
+ * SpMV does 2 flops per nonzero while reading a value, an index and a
+ * random element of x, so it is bound by memory bandwidth and by how
+ * local the accesses to x are.
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - Indices within a row (CSR) or column (CSC) are sorted and unique
+ * - Building from COO triplets is two counting sorts, O(nnz + rows + cols),
+ *   and duplicate triplets are summed as in finite-element assembly
+ * - Parallel loops split rows so that every task gets a similar number of
+ *   nonzeros, not of rows
+ */
+namespace linalg {
+
+/**
+ * @brief Storage order of a SparseMatrix
+ */
+enum class sparse_format { csr, csc };
+
+/**
+ * @brief One (row, col, value) entry of a matrix in coordinate (COO) form
+ */
+template<typename T>
+struct Triplet {
+    size_t row;
+    size_t col;
+    T value;
+};
+
+/**
+ * @brief Nonzero count from which sparse kernels run on the thread pool
+ */
+constexpr size_t sparse_parallel_limit = size_t(1) << 15;
+
+namespace detail {
+
+/**
+ * @brief Runs fn(begin, end) over chunks of [0, outer) holding similar
+ * numbers of nonzeros, in parallel when there are enough of them
+ *
+ * offsets has outer + 1 entries; work is the total cost of the loop.
+ */
+template<typename F>
+void sparse_for_chunks(const size_t* offsets, size_t outer, size_t work, F&& fn) {
+    ThreadPool& pool = default_thread_pool();
+    const size_t threads = pool.num_threads();
+    if (work < sparse_parallel_limit || threads == 1 || outer < 2) {
+        fn(size_t(0), outer);
+        return;
+    }
+    const size_t nnz = offsets[outer];
+    const size_t chunks = std::min(outer, 4 * threads);
+    // Chunk c starts at the first row whose offset reaches c/chunks of nnz
+    auto boundary = [&](size_t c) -> size_t {
+        if (c == chunks) return outer;
+        return static_cast<size_t>(std::lower_bound(offsets, offsets + outer, nnz / chunks * c) - offsets);
+    };
+    pool.parallel_for(chunks, [&](size_t c) {
+        const size_t begin = boundary(c), end = boundary(c + 1);
+        if (begin < end) fn(begin, end);
+    });
+}
+
+} // namespace detail
+
+template<typename T>
+class SparseMatrix;
+
+template<typename T>
+void sparse_triangular_solve(const SparseMatrix<T>& A, Vector<T>& x, bool lower, bool unit_diagonal = false);
+
+/**
+ * @brief Sparse matrix in compressed row (CSR) or column (CSC) storage
+ *
+ * EDUCATIONAL NOTE:
+ * Assemble from triplets, convert once to the format the hot loop wants,
+ * then reuse the pattern:
+ *
+ *   std::vector<linalg::Triplet<double>> entries = ...;
+ *   linalg::SparseMatrix<double> A(n, n, entries);   // CSR
+ *   Vector<double> y = A * x;                        // parallel SpMV
+ *
+ * The outer dimension is rows for CSR and columns for CSC; inner indices
+ * are the other coordinate.
+ */
+template<typename T>
+class SparseMatrix {
+private:
+    size_t rows;
+    size_t cols;
+    sparse_format layout;
+    std::vector<size_t> offsets;   // outer_size() + 1 starts into indices / vals
+    std::vector<size_t> indices;   // inner index of every stored entry
+    std::vector<T> vals;
+
+    size_t outer_size() const { return layout == sparse_format::csr ? rows : cols; }
+    size_t inner_size() const { return layout == sparse_format::csr ? cols : rows; }
+
+    static void check_dimensions(size_t r, size_t c) {
+        if (r == 0 || c == 0) {
+            throw std::invalid_argument("Matrix dimensions must be positive");
+        }
+    }
+
+    /**
+     * @brief Compresses n entries given by key accessors (counting sorts)
+     *
+     * Pass 1 orders the entries by inner index, pass 2 stably by outer
+     * index, so every outer slice comes out sorted; equal neighbours are
+     * then summed.
+     */
+    template<typename Outer, typename Inner, typename Value>
+    void compress(size_t n, Outer outer_of, Inner inner_of, Value value_of) {
+        std::vector<size_t> start(inner_size() + 1, 0);
+        for (size_t k = 0; k < n; ++k) ++start[inner_of(k) + 1];
+        for (size_t i = 0; i < inner_size(); ++i) start[i + 1] += start[i];
+        std::vector<size_t> by_inner(n);
+        for (size_t k = 0; k < n; ++k) by_inner[start[inner_of(k)]++] = k;
+
+        offsets.assign(outer_size() + 1, 0);
+        for (size_t k = 0; k < n; ++k) ++offsets[outer_of(k) + 1];
+        for (size_t o = 0; o < outer_size(); ++o) offsets[o + 1] += offsets[o];
+        std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        indices.resize(n);
+        vals.resize(n);
+        for (size_t k : by_inner) {
+            const size_t p = next[outer_of(k)]++;
+            indices[p] = inner_of(k);
+            vals[p] = value_of(k);
+        }
+
+        size_t write = 0;
+        for (size_t o = 0; o < outer_size(); ++o) {
+            const size_t begin = offsets[o], end = offsets[o + 1];
+            offsets[o] = write;
+            for (size_t p = begin; p < end; ++p) {
+                if (write > offsets[o] && indices[write - 1] == indices[p]) {
+                    vals[write - 1] += vals[p];
+                } else {
+                    indices[write] = indices[p];
+                    vals[write] = vals[p];
+                    ++write;
+                }
+            }
+        }
+        offsets[outer_size()] = write;
+        indices.resize(write);
+        vals.resize(write);
+    }
+
+public:
+    /**
+     * @brief All-zero r x c matrix
+     */
+    SparseMatrix(size_t r, size_t c, sparse_format format = sparse_format::csr)
+        : rows(r), cols(c), layout(format) {
+        check_dimensions(r, c);
+        offsets.assign(outer_size() + 1, 0);
+    }
+
+    /**
+     * @brief Builds the matrix from coordinate triplets in any order
+     *
+     * Duplicate (row, col) pairs are summed. Explicit zeros are kept in the
+     * pattern.
+     *
+     * @throws std::out_of_range if a triplet lies outside r x c
+     */
+    SparseMatrix(size_t r, size_t c, const std::vector<Triplet<T>>& triplets,
+                 sparse_format format = sparse_format::csr)
+        : rows(r), cols(c), layout(format) {
+        check_dimensions(r, c);
+        for (const Triplet<T>& t : triplets) {
+            if (t.row >= r || t.col >= c) {
+                throw std::out_of_range("Triplet index out of range");
+            }
+        }
+        const bool csr = format == sparse_format::csr;
+        compress(triplets.size(),
+                 [&](size_t k) { return csr ? triplets[k].row : triplets[k].col; },
+                 [&](size_t k) { return csr ? triplets[k].col : triplets[k].row; },
+                 [&](size_t k) { return triplets[k].value; });
+    }
+
+    /**
+     * @brief Compresses the nonzero entries of a dense matrix
+     */
+    explicit SparseMatrix(const Matrix<T>& dense, sparse_format format = sparse_format::csr)
+        : SparseMatrix(dense.get_rows(), dense.get_cols(), sparse_format::csr) {
+        for (size_t i = 0; i < rows; ++i) {
+            const T* row = dense.data() + i * dense.row_stride();
+            for (size_t j = 0; j < cols; ++j) {
+                if (row[j] != T(0)) {
+                    indices.push_back(j);
+                    vals.push_back(row[j]);
+                }
+            }
+            offsets[i + 1] = indices.size();
+        }
+        if (format != layout) *this = to_format(format);
+    }
+
+    /**
+     * @brief Dense copy (zeros filled in)
+     */
+    Matrix<T> to_dense() const {
+        Matrix<T> dense(rows, cols);
+        for (size_t o = 0; o < outer_size(); ++o) {
+            for (size_t p = offsets[o]; p < offsets[o + 1]; ++p) {
+                if (layout == sparse_format::csr) {
+                    dense(o, indices[p]) = vals[p];
+                } else {
+                    dense(indices[p], o) = vals[p];
+                }
+            }
+        }
+        return dense;
+    }
+
+    /**
+     * @brief The same matrix in the requested format
+     *
+     * EDUCATIONAL NOTE:
+     * Converting CSR to CSC is a counting sort of the entries by column:
+     * count entries per column, turn the counts into offsets, then walk
+     * the rows in order and drop every entry into its column. Because rows
+     * are visited in increasing order, each column comes out sorted.
+     * O(nnz + rows + cols).
+     */
+    SparseMatrix to_format(sparse_format format) const {
+        if (format == layout) return *this;
+        SparseMatrix result(rows, cols, format);
+        std::vector<size_t>& start = result.offsets;
+        for (size_t p = 0; p < nonzeros(); ++p) ++start[indices[p] + 1];
+        for (size_t i = 0; i < inner_size(); ++i) start[i + 1] += start[i];
+        result.indices.resize(nonzeros());
+        result.vals.resize(nonzeros());
+        std::vector<size_t> next(start.begin(), start.end() - 1);
+        for (size_t o = 0; o < outer_size(); ++o) {
+            for (size_t p = offsets[o]; p < offsets[o + 1]; ++p) {
+                const size_t q = next[indices[p]]++;
+                result.indices[q] = o;
+                result.vals[q] = vals[p];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Aᵀ without sorting: the arrays are reused with the format flipped
+     *
+     * The CSR arrays of A are the CSC arrays of Aᵀ, so this only copies.
+     */
+    SparseMatrix transpose() const {
+        SparseMatrix result(*this);
+        std::swap(result.rows, result.cols);
+        result.layout = layout == sparse_format::csr ? sparse_format::csc : sparse_format::csr;
+        return result;
+    }
+
+    /**
+     * @brief Value at (i, j), zero if not stored (binary search, O(log nnz per row))
+     *
+     * @throws std::out_of_range if (i, j) is outside the matrix
+     */
+    T at(size_t i, size_t j) const {
+        if (i >= rows || j >= cols) {
+            throw std::out_of_range("Matrix index out of range");
+        }
+        const size_t o = layout == sparse_format::csr ? i : j;
+        const size_t inner = layout == sparse_format::csr ? j : i;
+        const size_t* first = indices.data() + offsets[o];
+        const size_t* last = indices.data() + offsets[o + 1];
+        const size_t* it = std::lower_bound(first, last, inner);
+        return (it != last && *it == inner) ? vals[it - indices.data()] : T(0);
+    }
+
+    size_t get_rows() const { return rows; }
+    size_t get_cols() const { return cols; }
+    size_t nonzeros() const { return vals.size(); }
+    sparse_format format() const { return layout; }
+
+    /**
+     * @brief Raw compressed arrays for custom kernels
+     *
+     * Entries of outer slice o (row for CSR, column for CSC) are
+     * outer_offsets()[o] .. outer_offsets()[o + 1]. Values may be changed
+     * in place; the pattern may not.
+     */
+    const std::vector<size_t>& outer_offsets() const { return offsets; }
+    const std::vector<size_t>& inner_indices() const { return indices; }
+    std::vector<T>& values() { return vals; }
+    const std::vector<T>& values() const { return vals; }
+
+    /**
+     * @brief Solves L·x = b with L the lower triangle of this square matrix
+     *
+     * Entries above the diagonal are ignored.
+     *
+     * @throws std::invalid_argument if the matrix is not square or b has the wrong size
+     * @throws std::runtime_error if a diagonal entry is zero or missing
+     */
+    Vector<T> solve_lower(const Vector<T>& b) const {
+        Vector<T> x(b);
+        sparse_triangular_solve(*this, x, true, false);
+        return x;
+    }
+
+    /**
+     * @brief Solves U·x = b with U the upper triangle of this square matrix
+     *
+     * Entries below the diagonal are ignored.
+     *
+     * @throws std::invalid_argument if the matrix is not square or b has the wrong size
+     * @throws std::runtime_error if a diagonal entry is zero or missing
+     */
+    Vector<T> solve_upper(const Vector<T>& b) const {
+        Vector<T> x(b);
+        sparse_triangular_solve(*this, x, false, false);
+        return x;
+    }
+};
+
+/**
+ * @brief x := T⁻¹·x in place, T the lower or upper triangle of square A
+ *
+ * EDUCATIONAL NOTE:
+ * CSR substitutes row by row: x[i] = (x[i] - Σ a_ij·x[j]) / a_ii is a
+ * sparse dot product with already solved entries. CSC works column by
+ * column instead: once x[j] is final, it is subtracted from every x[i]
+ * below (lower) or above (upper) it. Both are sequential by nature; each
+ * step depends on the previous ones.
+ *
+ * @param unit_diagonal Treat the diagonal as ones without reading it (as
+ *        for the L of an incomplete LU stored together with U)
+ * @throws std::invalid_argument if A is not square or x has the wrong size
+ * @throws std::runtime_error if a needed diagonal entry is zero or missing
+ */
+template<typename T>
+void sparse_triangular_solve(const SparseMatrix<T>& A, Vector<T>& x, bool lower, bool unit_diagonal) {
+    const size_t n = A.get_rows();
+    if (A.get_cols() != n) {
+        throw std::invalid_argument("Triangular solve requires a square matrix");
+    }
+    if (x.size() != n) {
+        throw std::invalid_argument("Right-hand side size does not match the matrix");
+    }
+    const size_t* offsets = A.outer_offsets().data();
+    const size_t* indices = A.inner_indices().data();
+    const T* vals = A.values().data();
+    T* y = x.data();
+
+    for (size_t step = 0; step < n; ++step) {
+        const size_t k = lower ? step : n - 1 - step;
+        // Sorted indices: [first, split) lie before the diagonal, the rest on or after it
+        const size_t* first = indices + offsets[k];
+        const size_t* last = indices + offsets[k + 1];
+        const size_t* split = std::lower_bound(first, last, k);
+        const bool has_diagonal = split != last && *split == k;
+        T diagonal = T(1);
+        if (!unit_diagonal) {
+            if (!has_diagonal || vals[split - indices] == T(0)) {
+                throw std::runtime_error("Triangular matrix has a zero or missing diagonal entry");
+            }
+            diagonal = vals[split - indices];
+        }
+        const size_t before_end = static_cast<size_t>(split - indices);
+        const size_t after_begin = before_end + (has_diagonal ? 1 : 0);
+        // CSR lower and CSC upper use the entries before the diagonal
+        const bool before = (A.format() == sparse_format::csr) == lower;
+        const size_t begin = before ? offsets[k] : after_begin;
+        const size_t end = before ? before_end : offsets[k + 1];
+
+        if (A.format() == sparse_format::csr) {
+            T sum = y[k];
+            for (size_t p = begin; p < end; ++p) sum -= vals[p] * y[indices[p]];
+            y[k] = sum / diagonal;
+        } else {
+            y[k] /= diagonal;
+            const T yk = y[k];
+            for (size_t p = begin; p < end; ++p) y[indices[p]] -= vals[p] * yk;
+        }
+    }
+}
+
+namespace detail {
+
+/**
+ * @brief y[o] := alpha·(slice o)·x + beta·y[o] for every outer slice (gather)
+ */
+template<typename T>
+void sparse_gather(size_t outer, const size_t* offsets, const size_t* indices, const T* vals,
+                   T alpha, const T* x, T beta, T* y) {
+    sparse_for_chunks(offsets, outer, offsets[outer], [&](size_t begin, size_t end) {
+        for (size_t o = begin; o < end; ++o) {
+            T sum = T(0);
+            for (size_t p = offsets[o]; p < offsets[o + 1]; ++p) sum += vals[p] * x[indices[p]];
+            y[o] = beta == T(0) ? alpha * sum : alpha * sum + beta * y[o];
+        }
+    });
+}
+
+/**
+ * @brief y := beta·y, then y += alpha·x[o]·(slice o) for every outer slice (scatter)
+ */
+template<typename T>
+void sparse_scatter(size_t outer, size_t inner, const size_t* offsets, const size_t* indices,
+                    const T* vals, T alpha, const T* x, T beta, T* y) {
+    scale_vector(inner, beta, y);
+    for (size_t o = 0; o < outer; ++o) {
+        const T xo = alpha * x[o];
+        if (xo == T(0)) continue;
+        for (size_t p = offsets[o]; p < offsets[o + 1]; ++p) y[indices[p]] += vals[p] * xo;
+    }
+}
+
+template<typename T>
+void check_spmv(const SparseMatrix<T>& A, const Vector<T>& x, const Vector<T>& y, bool transposed) {
+    const size_t in = transposed ? A.get_rows() : A.get_cols();
+    const size_t out = transposed ? A.get_cols() : A.get_rows();
+    if (x.size() != in || y.size() != out) {
+        throw std::invalid_argument("Matrix and vector dimensions mismatch for multiplication");
+    }
+    if (x.data() == y.data()) {
+        throw std::invalid_argument("Output vector must not alias the input vector");
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief y := alpha·A·x + beta·y for sparse A
+ *
+ * CSR runs in parallel over balanced row chunks; CSC is a serial scatter.
+ * Convert with to_format(sparse_format::csr) before repeated products.
+ *
+ * @throws std::invalid_argument on dimension mismatch or if y aliases x
+ */
+template<typename T>
+void spmv(T alpha, const SparseMatrix<T>& A, const Vector<T>& x, T beta, Vector<T>& y) {
+    detail::check_spmv(A, x, y, false);
+    const size_t* offsets = A.outer_offsets().data();
+    const size_t* indices = A.inner_indices().data();
+    if (A.format() == sparse_format::csr) {
+        detail::sparse_gather(A.get_rows(), offsets, indices, A.values().data(), alpha, x.data(), beta, y.data());
+    } else {
+        detail::sparse_scatter(A.get_cols(), A.get_rows(), offsets, indices, A.values().data(),
+                               alpha, x.data(), beta, y.data());
+    }
+}
+
+/**
+ * @brief y := alpha·Aᵀ·x + beta·y without forming Aᵀ
+ *
+ * The roles swap: CSC gathers in parallel, CSR scatters serially.
+ *
+ * @throws std::invalid_argument on dimension mismatch or if y aliases x
+ */
+template<typename T>
+void spmv_transposed(T alpha, const SparseMatrix<T>& A, const Vector<T>& x, T beta, Vector<T>& y) {
+    detail::check_spmv(A, x, y, true);
+    const size_t* offsets = A.outer_offsets().data();
+    const size_t* indices = A.inner_indices().data();
+    if (A.format() == sparse_format::csc) {
+        detail::sparse_gather(A.get_cols(), offsets, indices, A.values().data(), alpha, x.data(), beta, y.data());
+    } else {
+        detail::sparse_scatter(A.get_rows(), A.get_cols(), offsets, indices, A.values().data(),
+                               alpha, x.data(), beta, y.data());
+    }
+}
+
+} // namespace linalg
+
+/**
+ * @brief Sparse matrix-vector product A·x
+ *
+ * @throws std::invalid_argument if A.get_cols() != x.size()
+ */
+template<typename T>
+Vector<T> operator*(const linalg::SparseMatrix<T>& A, const Vector<T>& x) {
+    Vector<T> y(A.get_rows());
+    linalg::spmv(T(1), A, x, T(0), y);
+    return y;
+}
+
+/**
+ * @brief Sparse-dense product A·B
+ *
+ * EDUCATIONAL NOTE:
+ * Row i of A·B is Σ a_ik · (row k of B): one SIMD axpy of a dense row per
+ * nonzero. For CSR, rows of the result are independent and split across
+ * threads by nonzero count. For CSC, tasks instead own slices of the
+ * result's columns and all apply every nonzero to their slice, so no two
+ * tasks write the same element.
+ *
+ * @throws std::invalid_argument if A.get_cols() != B.get_rows()
+ */
+template<typename T>
+Matrix<T> operator*(const linalg::SparseMatrix<T>& A, const Matrix<T>& B) {
+    if (A.get_cols() != B.get_rows()) {
+        throw std::invalid_argument("Matrix dimensions mismatch for multiplication");
+    }
+    const size_t n = B.get_cols();
+    Matrix<T> C(A.get_rows(), n);
+    const size_t* offsets = A.outer_offsets().data();
+    const size_t* indices = A.inner_indices().data();
+    const T* vals = A.values().data();
+    const T* b = B.data();
+    T* c = C.data();
+    if (A.format() == linalg::sparse_format::csr) {
+        linalg::detail::sparse_for_chunks(offsets, A.get_rows(), A.nonzeros() * n, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+                    linalg::simd::axpy(n, vals[p], b + indices[p] * n, c + i * n);
+                }
+            }
+        });
+    } else {
+        linalg::detail::gemv_for_chunks(n, A.nonzeros() * n, 64, [&](size_t begin, size_t end) {
+            for (size_t k = 0; k < A.get_cols(); ++k) {
+                for (size_t p = offsets[k]; p < offsets[k + 1]; ++p) {
+                    linalg::simd::axpy(end - begin, vals[p], b + k * n + begin, c + indices[p] * n + begin);
+                }
+            }
+        });
+    }
+    return C;
+}
+
+#endif // SPARSE_HPP
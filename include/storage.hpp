@@ -0,0 +1,544 @@
+#ifndef STORAGE_HPP
+#define STORAGE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Aligned, NUMA-aware storage for matrix elements
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Where a buffer lives matters as much as how it is traversed:
+ *
+ * 1. Alignment: SIMD loads are fastest when a row starts on a cache line
+ *    (64 bytes). operator new only promises 16.
+ * 2. Huge pages: a 4 KiB page covers 512 doubles, so streaming a 1 GiB
+ *    matrix walks 262144 pages and misses the TLB constantly. Transparent
+ *    2 MiB pages (requested with madvise) cut that by a factor of 512.
+ * 3. NUMA placement: on a multi-socket server every socket has its own
+ *    memory. Linux places a page on the node of the thread that first
+ *    writes it, so a matrix zero-filled by one thread lives entirely on one
+ *    socket, and threads on the other sockets read it over the slower
+ *    interconnect. Interleaving the pages round-robin over all nodes lets
+ *    every socket's memory controller serve a share of the traffic.
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * - StoragePolicy describes alignment, huge pages and NUMA placement
+ * - A process-wide default (set_storage_policy, or the LINALG_NUMA and
+ *   LINALG_HUGE_PAGES environment variables) is used by new matrices
+ * - Buffers that need page-level control are mapped directly with mmap and
+ *   placed with the mbind system call, so no libnuma dependency is needed
+ * - An Arena made current with ArenaScope serves the allocations of its
+ *   thread from one pre-reserved block and frees them all at once
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - NUMA placement applies to buffers of at least mapped_storage_limit
+ *   bytes, mapped with ordinary pages; huge pages only to buffers of at
+ *   least one huge page (2 MiB). Rounding a smaller buffer up to 2 MiB
+ *   would multiply its memory use. Everything else uses aligned
+ *   operator new
+ * - Placement is a hint: on single-node machines, or kernels without NUMA
+ *   support, mbind fails silently and the buffer is used as is
+ * - On non-Linux systems every buffer uses aligned operator new
+ */
+namespace linalg {
+
+/**
+ * @brief Buffers at least this large honor NUMA placement requests (huge
+ * pages additionally need a buffer of at least one huge page)
+ */
+constexpr size_t mapped_storage_limit = size_t(1) << 16;
+
+/**
+ * @brief Which NUMA node(s) the pages of a buffer come from
+ */
+enum class numa_placement {
+    first_touch,  // OS default: the node of the thread that first writes a page
+    interleave,   // round-robin over all online nodes (best for shared data)
+    node_local    // StoragePolicy::node, or the allocating thread's node if negative
+};
+
+struct StoragePolicy {
+    size_t alignment = 64;  // bytes, a power of two
+    bool huge_pages = false;
+    numa_placement placement = numa_placement::first_touch;
+    int node = -1;  // used by numa_placement::node_local
+};
+
+class Arena;
+
+namespace detail {
+
+inline void check_storage_policy(const StoragePolicy& policy) {
+    if (policy.alignment == 0 || (policy.alignment & (policy.alignment - 1)) != 0) {
+        throw std::invalid_argument("Storage alignment must be a power of two");
+    }
+}
+
+inline StoragePolicy storage_policy_from_env() {
+    StoragePolicy policy;
+    if (const char* env = std::getenv("LINALG_NUMA")) {
+        if (std::strcmp(env, "interleave") == 0) policy.placement = numa_placement::interleave;
+        if (std::strcmp(env, "local") == 0) policy.placement = numa_placement::node_local;
+    }
+    if (const char* env = std::getenv("LINALG_HUGE_PAGES")) {
+        policy.huge_pages = std::strcmp(env, "1") == 0;
+    }
+    return policy;
+}
+
+inline std::mutex& storage_policy_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline StoragePolicy& storage_policy_slot() {
+    static StoragePolicy policy = storage_policy_from_env();
+    return policy;
+}
+
+// Bumped by every set_storage_policy; threads refresh their cached copy
+// only when it changes
+inline std::atomic<size_t>& storage_policy_generation() {
+    static std::atomic<size_t> generation{1};
+    return generation;
+}
+
+struct CachedStoragePolicy {
+    size_t generation = 0;
+    StoragePolicy policy;
+};
+
+#if defined(__linux__)
+
+constexpr size_t huge_page_size = size_t(2) << 20;
+constexpr size_t numa_mask_words = 16;  // up to 1024 nodes
+constexpr int mpol_preferred = 1;       // values from <linux/mempolicy.h>
+constexpr int mpol_interleave = 3;
+
+struct NodeMask {
+    unsigned long words[numa_mask_words] = {};
+    size_t count = 0;
+};
+
+/**
+ * @brief Online NUMA nodes, parsed once from sysfs ("0-1,4" style lists)
+ */
+inline const NodeMask& online_nodes() {
+    static const NodeMask mask = [] {
+        NodeMask m;
+        constexpr size_t bits = numa_mask_words * 8 * sizeof(unsigned long);
+        if (std::FILE* file = std::fopen("/sys/devices/system/node/online", "r")) {
+            unsigned first = 0, last = 0;
+            while (std::fscanf(file, "%u", &first) == 1) {
+                last = first;
+                int next = std::fgetc(file);
+                if (next == '-' && std::fscanf(file, "%u", &last) == 1) next = std::fgetc(file);
+                for (unsigned n = first; n <= last && n < bits; ++n) {
+                    m.words[n / (8 * sizeof(unsigned long))] |= 1ul << (n % (8 * sizeof(unsigned long)));
+                    ++m.count;
+                }
+                if (next != ',') break;
+            }
+            std::fclose(file);
+        }
+        return m;
+    }();
+    return mask;
+}
+
+inline int current_node() {
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return 0;
+    return static_cast<int>(node);
+}
+
+inline void apply_placement(void* p, size_t bytes, const StoragePolicy& policy) {
+    if (policy.placement == numa_placement::first_touch || online_nodes().count < 2) return;
+    NodeMask mask;
+    int mode = mpol_interleave;
+    if (policy.placement == numa_placement::interleave) {
+        mask = online_nodes();
+    } else {
+        const size_t node = static_cast<size_t>(policy.node >= 0 ? policy.node : current_node());
+        if (node >= numa_mask_words * 8 * sizeof(unsigned long)) return;
+        mask.words[node / (8 * sizeof(unsigned long))] = 1ul << (node % (8 * sizeof(unsigned long)));
+        mode = mpol_preferred;
+    }
+    // The kernel reads maxnode - 1 bits of the mask; a failure leaves the
+    // default first-touch placement, which is always correct
+    syscall(SYS_mbind, p, bytes, mode, mask.words,
+            numa_mask_words * 8 * sizeof(unsigned long) + 1, 0u);
+}
+
+#endif // __linux__
+
+/**
+ * @brief One raw allocation and how to give it back
+ */
+struct StorageBlock {
+    void* pointer = nullptr;
+    size_t bytes = 0;       // length of the mapping, or of the aligned allocation
+    size_t alignment = 0;
+    bool mapped = false;    // from mmap (zero-filled) rather than operator new
+    Arena* arena = nullptr; // carved out of an arena, released with it
+};
+
+inline StorageBlock allocate_system_block(size_t bytes, const StoragePolicy& policy) {
+    StorageBlock block;
+    block.alignment = policy.alignment;
+#if defined(__linux__)
+    // Huge pages only pay off (and only stay cheap) for buffers spanning at
+    // least one; NUMA placement alone works at ordinary page granularity
+    const bool huge = policy.huge_pages && bytes >= huge_page_size;
+    const bool placed = policy.placement != numa_placement::first_touch && bytes >= mapped_storage_limit;
+    const size_t page = huge ? huge_page_size : static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if ((huge || placed) && policy.alignment <= page) {
+        const size_t length = (bytes + page - 1) / page * page;
+        // Over-map by one huge page so the buffer can start on a 2 MiB boundary
+        const size_t slack = huge ? page : 0;
+        void* map = mmap(nullptr, length + slack, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED) throw std::bad_alloc();
+        char* start = static_cast<char*>(map);
+        if (slack) {
+            char* aligned = reinterpret_cast<char*>(
+                (reinterpret_cast<uintptr_t>(start) + page - 1) / page * page);
+            if (aligned != start) munmap(start, aligned - start);
+            if (aligned + length != start + length + slack) {
+                munmap(aligned + length, (start + length + slack) - (aligned + length));
+            }
+            start = aligned;
+#if defined(MADV_HUGEPAGE)
+            madvise(start, length, MADV_HUGEPAGE);
+#endif
+        }
+        apply_placement(start, length, policy);
+        block.pointer = start;
+        block.bytes = length;
+        block.mapped = true;
+        return block;
+    }
+#endif
+    block.pointer = ::operator new(bytes, std::align_val_t{policy.alignment});
+    block.bytes = bytes;
+    return block;
+}
+
+inline void release_system_block(const StorageBlock& block) noexcept {
+    if (!block.pointer) return;
+#if defined(__linux__)
+    if (block.mapped) {
+        munmap(block.pointer, block.bytes);
+        return;
+    }
+#endif
+    ::operator delete(block.pointer, std::align_val_t{block.alignment});
+}
+
+} // namespace detail
+
+/**
+ * @brief The policy used by matrices constructed without one
+ *
+ * Every Matrix and heap Vector reads this on construction, so it must not
+ * lock: each thread keeps a copy and only takes the mutex to refresh it
+ * after set_storage_policy has bumped the generation counter.
+ */
+inline StoragePolicy default_storage_policy() {
+    thread_local detail::CachedStoragePolicy cache;
+    if (cache.generation != detail::storage_policy_generation().load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(detail::storage_policy_mutex());
+        cache.policy = detail::storage_policy_slot();
+        cache.generation = detail::storage_policy_generation().load(std::memory_order_relaxed);
+    }
+    return cache.policy;
+}
+
+/**
+ * @brief Replaces the default policy; existing buffers keep their placement
+ *
+ * @throws std::invalid_argument if the alignment is not a power of two
+ */
+inline void set_storage_policy(const StoragePolicy& policy) {
+    detail::check_storage_policy(policy);
+    std::lock_guard<std::mutex> lock(detail::storage_policy_mutex());
+    detail::storage_policy_slot() = policy;
+    detail::storage_policy_generation().fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Number of online NUMA nodes (1 on non-NUMA or non-Linux systems)
+ */
+inline size_t numa_nodes() {
+#if defined(__linux__)
+    return std::max<size_t>(1, detail::online_nodes().count);
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief Bump allocator for short-lived temporaries
+ * 
+ * EDUCATIONAL NOTE:
+ * A computation step such as "factor, solve, multiply, transpose" creates
+ * a handful of temporary matrices and vectors and destroys them all before
+ * the next step. A general-purpose allocator handles each one separately,
+ * with locking, size-class lookups and (for large blocks) mmap and munmap
+ * system calls. An arena reserves one block up front and hands out
+ * consecutive slices of it:
+ * 
+ *   allocate:  round the offset up to the alignment, advance it   O(1)
+ *   free:      only count the allocation as released              O(1)
+ *   reset:     set the offset back to zero, all at once           O(1)
+ * 
+ * Usage:
+ * 
+ *   linalg::Arena arena(64 << 20);        // reserve 64 MiB once
+ *   for (auto& step : steps) {
+ *       linalg::ArenaScope scope(arena);  // this thread now allocates from arena
+ *       Matrix<double> x = linalg::solve_linear_system(step.A, step.B);
+ *       result += x;                      // result was allocated outside
+ *   }                                     // temporaries gone, arena rewound
+ * 
+ * RULES:
+ * 1. Objects allocated inside a scope must be destroyed before it ends;
+ *    debug builds assert this. Moving one out (push_back into an outer
+ *    container, assignment, returning std::move'd or as a prvalue) copies
+ *    it into system memory, which is fine. A named local returned as
+ *    `return t;` is not moved at all (the compiler builds it directly in
+ *    the caller's object), so from inside a function's own scope return
+ *    `Matrix<T>(std::move(t))` instead
+ * 2. Requests that do not fit fall back to the normal allocator, so an
+ *    undersized arena is slower but still correct
+ * 3. An arena serves one thread at a time; threads of the pool allocate
+ *    normally even while the calling thread has a scope open
+ */
+class Arena {
+private:
+    detail::StorageBlock block;
+    size_t size;      // usable bytes (a mapped block may be rounded up)
+    size_t offset = 0;
+    size_t live = 0;  // allocations not yet released
+
+    friend class ArenaScope;
+
+public:
+    explicit Arena(size_t bytes, const StoragePolicy& policy = default_storage_policy()) : size(bytes) {
+        detail::check_storage_policy(policy);
+        if (bytes == 0) {
+            throw std::invalid_argument("Arena size must be positive");
+        }
+        block = detail::allocate_system_block(bytes, policy);
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        assert(live == 0 && "Arena destroyed while objects still use it");
+        detail::release_system_block(block);
+    }
+
+    /**
+     * @brief Returns bytes aligned to alignment, or nullptr if they do not fit
+     */
+    void* allocate(size_t bytes, size_t alignment) noexcept {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.pointer);
+        const uintptr_t start = (base + offset + alignment - 1) / alignment * alignment;
+        if (start - base > size || bytes > size - (start - base)) return nullptr;
+        offset = start - base + bytes;
+        ++live;
+        return reinterpret_cast<void*>(start);
+    }
+
+    void release() noexcept {
+        assert(live > 0);
+        --live;
+    }
+
+    /**
+     * @brief Makes the whole block available again
+     */
+    void reset() noexcept {
+        assert(live == 0 && "Arena reset while objects still use it");
+        offset = 0;
+    }
+
+    size_t capacity() const noexcept { return size; }
+    size_t used() const noexcept { return offset; }
+    size_t live_allocations() const noexcept { return live; }
+};
+
+namespace detail {
+
+inline Arena*& current_arena() {
+    thread_local Arena* arena = nullptr;
+    return arena;
+}
+
+} // namespace detail
+
+/**
+ * @brief Makes an arena current for this thread until the scope ends
+ * 
+ * Scopes nest: the previous arena (or none) becomes current again at the
+ * end, and everything allocated inside the scope is freed by rewinding
+ * the arena to where it was when the scope began.
+ */
+class ArenaScope {
+private:
+    Arena& arena;
+    Arena* previous;
+    size_t mark;
+    size_t live_at_entry;
+
+public:
+    explicit ArenaScope(Arena& a)
+        : arena(a), previous(detail::current_arena()), mark(a.offset), live_at_entry(a.live) {
+        detail::current_arena() = &arena;
+    }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    ~ArenaScope() {
+        assert(arena.live == live_at_entry && "Object allocated in an ArenaScope outlived it");
+        arena.offset = mark;
+        detail::current_arena() = previous;
+    }
+};
+
+/**
+ * @brief Suspends the current arena on this thread until the scope ends
+ * 
+ * Only objects constructed inside an ArenaScope may take arena memory.
+ * An object that already existed when the scope opened and grows inside
+ * it (resize, assignment of a larger value, a workspace adding buffers)
+ * outlives the scope, so its new buffer must come from the system: an
+ * arena buffer would be handed out again after the scope rewinds.
+ */
+class SystemAllocationScope {
+private:
+    Arena* previous;
+
+public:
+    SystemAllocationScope() noexcept : previous(detail::current_arena()) {
+        detail::current_arena() = nullptr;
+    }
+
+    SystemAllocationScope(const SystemAllocationScope&) = delete;
+    SystemAllocationScope& operator=(const SystemAllocationScope&) = delete;
+
+    ~SystemAllocationScope() { detail::current_arena() = previous; }
+};
+
+namespace detail {
+
+/**
+ * @brief Allocates from the current arena if there is room, else from the system
+ */
+inline StorageBlock allocate_block(size_t bytes, const StoragePolicy& policy) {
+    if (Arena* arena = current_arena()) {
+        if (void* p = arena->allocate(bytes, policy.alignment)) {
+            StorageBlock block;
+            block.pointer = p;
+            block.bytes = bytes;
+            block.alignment = policy.alignment;
+            block.arena = arena;
+            return block;
+        }
+    }
+    return allocate_system_block(bytes, policy);
+}
+
+inline void release_block(const StorageBlock& block) noexcept {
+    if (block.arena) {
+        block.arena->release();
+    } else {
+        release_system_block(block);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief unique_ptr deleter that destroys n elements and releases their block
+ */
+template<typename T>
+struct StorageDeleter {
+    detail::StorageBlock block;
+    size_t count = 0;
+
+    void operator()(T* p) const noexcept {
+        std::destroy_n(p, count);
+        detail::release_block(block);
+    }
+};
+
+template<typename T>
+using storage_ptr = std::unique_ptr<T[], StorageDeleter<T>>;
+
+/**
+ * @brief Whether a buffer was carved out of an arena
+ * 
+ * Such a buffer disappears when its ArenaScope ends, so containers copy it
+ * instead of adopting it when moved into an object that may live longer.
+ */
+template<typename T>
+bool from_arena(const storage_ptr<T>& p) noexcept {
+    return p && p.get_deleter().block.arena != nullptr;
+}
+
+/**
+ * @brief Allocates n elements of T following policy
+ *
+ * With zero_fill the elements are value-initialized (zero for arithmetic
+ * types; mapped buffers already are, so they are not written again).
+ * Otherwise they are default-initialized, i.e. left untouched.
+ */
+template<typename T>
+storage_ptr<T> allocate_storage(size_t n, const StoragePolicy& policy, bool zero_fill) {
+    detail::check_storage_policy(policy);
+    StoragePolicy effective = policy;
+    if (effective.alignment < alignof(T)) effective.alignment = alignof(T);
+
+    const detail::StorageBlock block = detail::allocate_block(n * sizeof(T), effective);
+    T* elements = static_cast<T*>(block.pointer);
+    try {
+        if (zero_fill && !(block.mapped && std::is_trivially_default_constructible_v<T>)) {
+            std::uninitialized_value_construct_n(elements, n);
+        } else {
+            std::uninitialized_default_construct_n(elements, n);
+        }
+    } catch (...) {
+        detail::release_block(block);
+        throw;
+    }
+    return storage_ptr<T>(elements, StorageDeleter<T>{block, n});
+}
+
+} // namespace linalg
+
+#endif // STORAGE_HPP
@@ -0,0 +1,402 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @brief Reusable work-stealing thread pool
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Creating a thread costs tens of microseconds, so libraries keep a pool of
+ * long-lived worker threads and hand them small tasks instead.
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * 1. Work stealing: every worker owns a deque of tasks. It pops from the
+ *    back of its own deque (good cache locality) and, when that runs dry,
+ *    steals from the front of another worker's deque (load balancing)
+ * 2. Fork-join: parallel_for() splits work into tasks, and the calling
+ *    thread helps execute them until all are done, so nested parallel
+ *    calls cannot deadlock
+ * 3. Thread pinning: binding each worker to one core keeps its caches warm
+ *    and stops the OS from migrating it between sockets
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - The pool has num_threads - 1 workers; the caller is the last participant
+ * - Tasks reference the caller's callable, so no std::function allocations,
+ *   and the queues are grow-only rings: once warmed up, parallel_for()
+ *   does not touch the heap
+ * - The first exception thrown by a task is rethrown by parallel_for()
+ * - default_thread_pool() is sized by LINALG_NUM_THREADS (default: all
+ *   hardware threads); LINALG_PIN_THREADS=1 enables pinning
+ */
+namespace linalg {
+
+class ThreadPool;
+
+namespace detail {
+
+/**
+ * @brief Completion tracking for one parallel_for() call
+ */
+class TaskGroup {
+private:
+    std::mutex mutex;
+    std::condition_variable done;
+    std::atomic<size_t> remaining;
+    std::exception_ptr error;
+
+public:
+    explicit TaskGroup(size_t count) : remaining(count) {}
+
+    bool finished() const {
+        return remaining.load(std::memory_order_acquire) == 0;
+    }
+
+    void finish_one(std::exception_ptr failure) {
+        // Decrement under the lock: the waiter must not destroy the group
+        // until the last finisher has released it
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failure && !error) error = failure;
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done.notify_all();
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return finished(); });
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+struct Task {
+    void (*invoke)(void* context, size_t index);
+    void* context;
+    size_t index;
+    TaskGroup* group;
+};
+
+/**
+ * @brief Double-ended task queue on a grow-only ring buffer
+ *
+ * std::deque allocates and frees node blocks as it fills and drains, so
+ * every parallel_for() would hit the heap. The ring only reallocates when
+ * more tasks are queued than ever before; steady-state dispatch (solvers
+ * calling the same kernels each iteration) allocates nothing.
+ */
+class TaskDeque {
+private:
+    std::vector<Task> ring;          // capacity is zero or a power of two
+    size_t head = 0;                 // index of the front task
+    size_t count = 0;
+
+    void grow() {
+        std::vector<Task> larger(ring.empty() ? 64 : 2 * ring.size());
+        for (size_t i = 0; i < count; ++i) larger[i] = ring[(head + i) & (ring.size() - 1)];
+        ring.swap(larger);
+        head = 0;
+    }
+
+public:
+    bool empty() const { return count == 0; }
+
+    void push_back(const Task& task) {
+        if (count == ring.size()) grow();
+        ring[(head + count) & (ring.size() - 1)] = task;
+        ++count;
+    }
+
+    Task pop_back() {
+        --count;
+        return ring[(head + count) & (ring.size() - 1)];
+    }
+
+    Task pop_front() {
+        const Task task = ring[head];
+        head = (head + 1) & (ring.size() - 1);
+        --count;
+        return task;
+    }
+};
+
+struct WorkQueue {
+    std::mutex mutex;
+    TaskDeque tasks;
+};
+
+// Identifies the pool (and queue) of the current worker thread, if any
+struct WorkerIdentity {
+    const ThreadPool* pool = nullptr;
+    size_t index = 0;
+};
+
+inline WorkerIdentity& current_worker() {
+    thread_local WorkerIdentity identity;
+    return identity;
+}
+
+inline size_t env_size(const char* name, size_t fallback) {
+    if (const char* value = std::getenv(name)) {
+        char* end = nullptr;
+        const unsigned long parsed = std::strtoul(value, &end, 10);
+        if (end != value && parsed > 0) return static_cast<size_t>(parsed);
+    }
+    return fallback;
+}
+
+} // namespace detail
+
+/**
+ * @brief Number of threads used when none is specified
+ */
+inline size_t default_num_threads() {
+    return detail::env_size("LINALG_NUM_THREADS",
+                            std::max<size_t>(1, std::thread::hardware_concurrency()));
+}
+
+class ThreadPool {
+private:
+    std::vector<std::unique_ptr<detail::WorkQueue>> queues;  // workers + one for outside callers
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending{0};
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+public:
+    /**
+     * @brief Starts num_threads - 1 workers (the caller is the last thread)
+     *
+     * @param num_threads Total participants, including the calling thread
+     * @param pin_threads Bind worker i to logical CPU i + 1 (Linux only)
+     */
+    explicit ThreadPool(size_t num_threads = default_num_threads(),
+                        bool pin_threads = detail::env_size("LINALG_PIN_THREADS", 0) != 0) {
+        if (num_threads == 0) {
+            throw std::invalid_argument("Thread pool needs at least one thread");
+        }
+        const size_t worker_count = num_threads - 1;
+        for (size_t i = 0; i <= worker_count; ++i) {
+            queues.push_back(std::make_unique<detail::WorkQueue>());
+        }
+        workers.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i) {
+            workers.emplace_back([this, i, pin_threads] { worker_loop(i, pin_threads); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Total participants (workers plus the calling thread)
+     */
+    size_t num_threads() const { return workers.size() + 1; }
+
+    /**
+     * @brief Calls fn(i) for every i in [0, count) and waits for completion
+     *
+     * EDUCATIONAL NOTE:
+     * Each index becomes one task, so callers should choose count to give a
+     * few tasks per thread (e.g. output tiles), not one per element. The
+     * calling thread executes tasks too, so the call is safe to nest.
+     */
+    template<typename F>
+    void parallel_for(size_t count, F&& fn) {
+        if (count == 0) return;
+        if (count == 1 || workers.empty()) {
+            for (size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+
+        using Fn = std::remove_reference_t<F>;
+        detail::TaskGroup group(count);
+        void* context = const_cast<void*>(static_cast<const void*>(&fn));
+        auto invoke = [](void* ctx, size_t index) { (*static_cast<Fn*>(ctx))(index); };
+
+        const size_t home = home_queue();
+        for (size_t i = 0; i < count; ++i) {
+            detail::WorkQueue& queue = *queues[(home + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(detail::Task{invoke, context, i, &group});
+        }
+        pending.fetch_add(count, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+        }
+        wake.notify_all();
+
+        // Help until no queued work is left, then wait for in-flight tasks
+        detail::Task task;
+        while (!group.finished() && try_pop(home, task)) {
+            run(task);
+        }
+        group.wait();
+    }
+
+private:
+    size_t home_queue() const {
+        const detail::WorkerIdentity& self = detail::current_worker();
+        return self.pool == this ? self.index : workers.size();
+    }
+
+    /**
+     * @brief Pops from the back of our own queue, else steals from the front
+     * of the others
+     */
+    bool try_pop(size_t home, detail::Task& out) {
+        {
+            detail::WorkQueue& own = *queues[home];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                out = own.tasks.pop_back();
+                pending.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues.size(); ++offset) {
+            detail::WorkQueue& victim = *queues[(home + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                out = victim.tasks.pop_front();
+                pending.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void run(const detail::Task& task) {
+        std::exception_ptr failure;
+        try {
+            task.invoke(task.context, task.index);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        task.group->finish_one(failure);
+    }
+
+    static void pin_to_cpu(size_t cpu) {
+#if defined(__linux__)
+        const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu % hardware, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)cpu;
+#endif
+    }
+
+    void worker_loop(size_t index, bool pin_threads) {
+        detail::current_worker() = detail::WorkerIdentity{this, index};
+        if (pin_threads) pin_to_cpu(index + 1);
+
+        detail::Task task;
+        for (;;) {
+            if (try_pop(index, task)) {
+                run(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [this] {
+                return stopping || pending.load(std::memory_order_acquire) > 0;
+            });
+            if (stopping && pending.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+};
+
+namespace detail {
+
+// Serializes creation and replacement of the default pool
+inline std::mutex& default_pool_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::unique_ptr<ThreadPool>& default_pool_slot() {
+    static std::unique_ptr<ThreadPool> pool;
+    return pool;
+}
+
+// Published pool, read lock-free by every kernel dispatch
+inline std::atomic<ThreadPool*>& default_pool_pointer() {
+    static std::atomic<ThreadPool*> pointer{nullptr};
+    return pointer;
+}
+
+} // namespace detail
+
+/**
+ * @brief The library-owned pool used by parallel kernels (created lazily)
+ *
+ * Every parallel kernel calls this, so after the one-time creation it is a
+ * single atomic load: concurrent callers do not serialize on a lock.
+ */
+inline ThreadPool& default_thread_pool() {
+    static const bool created = [] {
+        std::lock_guard<std::mutex> lock(detail::default_pool_mutex());
+        std::unique_ptr<ThreadPool>& pool = detail::default_pool_slot();
+        if (!pool) {
+            pool = std::make_unique<ThreadPool>();
+            detail::default_pool_pointer().store(pool.get(), std::memory_order_release);
+        }
+        return true;
+    }();
+    (void)created;
+    return *detail::default_pool_pointer().load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Replaces the default pool with one of num_threads threads
+ *
+ * Must not be called while parallel kernels are running: the old pool is
+ * joined and destroyed here. The new pool is built before it is published,
+ * so default_thread_pool() never observes a missing pool.
+ */
+inline void set_num_threads(size_t num_threads, bool pin_threads = false) {
+    std::lock_guard<std::mutex> lock(detail::default_pool_mutex());
+    std::unique_ptr<ThreadPool> replacement = std::make_unique<ThreadPool>(num_threads, pin_threads);
+    // Publish the new pool in one step: readers never observe null
+    detail::default_pool_pointer().exchange(replacement.get(), std::memory_order_acq_rel);
+    detail::default_pool_slot().swap(replacement);
+    // replacement now holds the old pool, joined here
+}
+
+inline size_t get_num_threads() {
+    return default_thread_pool().num_threads();
+}
+
+} // namespace linalg
+
+#endif // THREAD_POOL_HPP
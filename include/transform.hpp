@@ -0,0 +1,315 @@
+#ifndef TRANSFORM_HPP
+#define TRANSFORM_HPP
+
+#include "fixed_matrix.hpp"
+#include "simd.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * @brief Batched transforms of 3D point clouds
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Rotating one point is 9 multiply-adds; rotating a million points is a
+ * streaming problem. Each point is read and written once, so the speed
+ * limit is memory bandwidth, and the job of the code is to stay out of the
+ * way: no per-point allocation, no bounds checks, SIMD arithmetic and all
+ * cores pulling data.
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * 1. Structure of arrays (SoA): xs[], ys[], zs[] in separate buffers. A
+ *    SIMD register then holds the x of 4 (AVX2) or 8 (AVX-512) points, and
+ *    the transform is plain vertical arithmetic on whole registers
+ * 2. Array of structures (AoS): x, y, z interleaved per point, optionally
+ *    padded (stride 4 for xyzw). Common in file formats and GPU buffers;
+ *    the compiler shuffles components in and out of registers
+ * 3. Affine vs projective: a 4x4 matrix whose last row is [0 0 0 1] is a
+ *    rotation plus translation; otherwise each result is divided by w
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - One loop body is compiled for SSE2, AVX2 and AVX-512 (function
+ *   multiversioning, see simd.hpp) and picked by simd::active_isa()
+ * - Points are independent, so large batches are split over the thread pool
+ * - All functions transform in place
+ */
+namespace linalg {
+
+/**
+ * @brief Point count above which transforms run on the thread pool
+ */
+constexpr size_t transform_parallel_limit = size_t(1) << 15;
+
+namespace detail {
+
+// Points per block of the SoA loop, a multiple of every SIMD width
+constexpr size_t transform_block = 16;
+
+/**
+ * @brief Coefficients of a 4x4 transform, row-major
+ */
+template<typename T>
+struct transform_coefficients {
+    T m[16];
+};
+
+template<typename T, bool Projective>
+LINALG_ALWAYS_INLINE void transform_point(const transform_coefficients<T>& t, T& x, T& y, T& z) {
+    const T* m = t.m;
+    const T px = x, py = y, pz = z;
+    T qx = m[0] * px + m[1] * py + m[2] * pz + m[3];
+    T qy = m[4] * px + m[5] * py + m[6] * pz + m[7];
+    T qz = m[8] * px + m[9] * py + m[10] * pz + m[11];
+    if constexpr (Projective) {
+        const T w = m[12] * px + m[13] * py + m[14] * pz + m[15];
+        qx /= w;
+        qy /= w;
+        qz /= w;
+    }
+    x = qx;
+    y = qy;
+    z = qz;
+}
+
+template<typename T, bool Projective>
+LINALG_ALWAYS_INLINE void transform_soa_body(transform_coefficients<T> t, T* xs, T* ys, T* zs, size_t n) {
+    size_t i = 0;
+    for (; i + transform_block <= n; i += transform_block) {
+        LINALG_IVDEP
+        for (size_t k = 0; k < transform_block; ++k) {
+            transform_point<T, Projective>(t, xs[i + k], ys[i + k], zs[i + k]);
+        }
+    }
+    for (; i < n; ++i) {
+        transform_point<T, Projective>(t, xs[i], ys[i], zs[i]);
+    }
+}
+
+/**
+ * @brief AoS loop; Stride is a compile-time constant for the common 3 and
+ * 4, or 0 to use the run-time stride
+ */
+template<typename T, bool Projective, size_t Stride>
+LINALG_ALWAYS_INLINE void transform_aos_body(transform_coefficients<T> t, T* xyz, size_t n, size_t stride) {
+    const size_t s = Stride != 0 ? Stride : stride;
+    LINALG_IVDEP
+    for (size_t i = 0; i < n; ++i) {
+        T* p = xyz + i * s;
+        transform_point<T, Projective>(t, p[0], p[1], p[2]);
+    }
+}
+
+template<typename T, bool Projective>
+LINALG_ALWAYS_INLINE void transform_aos_dispatch_stride(transform_coefficients<T> t, T* xyz, size_t n,
+                                                        size_t stride) {
+    if (stride == 3) {
+        transform_aos_body<T, Projective, 3>(t, xyz, n, stride);
+    } else if (stride == 4) {
+        transform_aos_body<T, Projective, 4>(t, xyz, n, stride);
+    } else {
+        transform_aos_body<T, Projective, 0>(t, xyz, n, stride);
+    }
+}
+
+// The same bodies, compiled once per instruction set
+template<typename T, bool Projective>
+void transform_soa_generic(transform_coefficients<T> t, T* xs, T* ys, T* zs, size_t n) {
+    transform_soa_body<T, Projective>(t, xs, ys, zs, n);
+}
+
+template<typename T, bool Projective>
+void transform_aos_generic(transform_coefficients<T> t, T* xyz, size_t n, size_t stride) {
+    transform_aos_dispatch_stride<T, Projective>(t, xyz, n, stride);
+}
+
+#if defined(LINALG_SIMD_X86)
+template<typename T, bool Projective>
+LINALG_TARGET_AVX2 void transform_soa_avx2(transform_coefficients<T> t, T* xs, T* ys, T* zs, size_t n) {
+    transform_soa_body<T, Projective>(t, xs, ys, zs, n);
+}
+
+template<typename T, bool Projective>
+LINALG_TARGET_AVX512 void transform_soa_avx512(transform_coefficients<T> t, T* xs, T* ys, T* zs, size_t n) {
+    transform_soa_body<T, Projective>(t, xs, ys, zs, n);
+}
+
+template<typename T, bool Projective>
+LINALG_TARGET_AVX2 void transform_aos_avx2(transform_coefficients<T> t, T* xyz, size_t n, size_t stride) {
+    transform_aos_dispatch_stride<T, Projective>(t, xyz, n, stride);
+}
+
+template<typename T, bool Projective>
+LINALG_TARGET_AVX512 void transform_aos_avx512(transform_coefficients<T> t, T* xyz, size_t n, size_t stride) {
+    transform_aos_dispatch_stride<T, Projective>(t, xyz, n, stride);
+}
+#endif
+
+template<typename T, bool Projective>
+void transform_soa(const transform_coefficients<T>& t, T* xs, T* ys, T* zs, size_t n) {
+#if defined(LINALG_SIMD_X86)
+    if constexpr (simd::has_kernels<T>) {
+        switch (simd::active_isa()) {
+        case simd::isa::avx512: return transform_soa_avx512<T, Projective>(t, xs, ys, zs, n);
+        case simd::isa::avx2: return transform_soa_avx2<T, Projective>(t, xs, ys, zs, n);
+        default: break;
+        }
+    }
+#endif
+    transform_soa_generic<T, Projective>(t, xs, ys, zs, n);
+}
+
+template<typename T, bool Projective>
+void transform_aos(const transform_coefficients<T>& t, T* xyz, size_t n, size_t stride) {
+#if defined(LINALG_SIMD_X86)
+    if constexpr (simd::has_kernels<T>) {
+        switch (simd::active_isa()) {
+        case simd::isa::avx512: return transform_aos_avx512<T, Projective>(t, xyz, n, stride);
+        case simd::isa::avx2: return transform_aos_avx2<T, Projective>(t, xyz, n, stride);
+        default: break;
+        }
+    }
+#endif
+    transform_aos_generic<T, Projective>(t, xyz, n, stride);
+}
+
+/**
+ * @brief Runs fn(first_point, point_count) over chunks of n points, in
+ * parallel for large batches
+ */
+template<typename F>
+void for_point_chunks(size_t n, F&& fn) {
+    if (n < transform_parallel_limit) {
+        fn(size_t(0), n);
+        return;
+    }
+    ThreadPool& pool = default_thread_pool();
+    const size_t threads = pool.num_threads();
+    if (threads == 1) {
+        fn(size_t(0), n);
+        return;
+    }
+    const size_t chunk = (std::max<size_t>(n / (4 * threads), 4096) + transform_block - 1)
+                         / transform_block * transform_block;
+    pool.parallel_for((n + chunk - 1) / chunk, [&](size_t c) {
+        const size_t first = c * chunk;
+        fn(first, std::min(chunk, n - first));
+    });
+}
+
+template<typename T>
+transform_coefficients<T> affine_coefficients(const FixedMatrix<T, 3, 3>& r) {
+    return {{r(0, 0), r(0, 1), r(0, 2), T(0),
+             r(1, 0), r(1, 1), r(1, 2), T(0),
+             r(2, 0), r(2, 1), r(2, 2), T(0),
+             T(0),    T(0),    T(0),    T(1)}};
+}
+
+template<typename T>
+transform_coefficients<T> affine_coefficients(const FixedMatrix<T, 4, 4>& h) {
+    transform_coefficients<T> t;
+    std::copy(h.data(), h.data() + 16, t.m);
+    return t;
+}
+
+template<typename T>
+bool is_affine(const FixedMatrix<T, 4, 4>& h) {
+    return h(3, 0) == T(0) && h(3, 1) == T(0) && h(3, 2) == T(0) && h(3, 3) == T(1);
+}
+
+template<typename T, size_t N>
+void transform_points_soa(const FixedMatrix<T, N, N>& m, T* xs, T* ys, T* zs, size_t n) {
+    const transform_coefficients<T> t = affine_coefficients(m);
+    bool projective = false;
+    if constexpr (N == 4) projective = !is_affine(m);
+    for_point_chunks(n, [&](size_t first, size_t count) {
+        if (projective) {
+            transform_soa<T, true>(t, xs + first, ys + first, zs + first, count);
+        } else {
+            transform_soa<T, false>(t, xs + first, ys + first, zs + first, count);
+        }
+    });
+}
+
+template<typename T, size_t N>
+void transform_points_aos(const FixedMatrix<T, N, N>& m, T* xyz, size_t n, size_t stride) {
+    if (stride < 3) {
+        throw std::invalid_argument("Point stride must be at least 3");
+    }
+    const transform_coefficients<T> t = affine_coefficients(m);
+    bool projective = false;
+    if constexpr (N == 4) projective = !is_affine(m);
+    for_point_chunks(n, [&](size_t first, size_t count) {
+        if (projective) {
+            transform_aos<T, true>(t, xyz + first * stride, count, stride);
+        } else {
+            transform_aos<T, false>(t, xyz + first * stride, count, stride);
+        }
+    });
+}
+
+} // namespace detail
+
+/**
+ * @brief Rotates (or otherwise linearly maps) n points stored as SoA, in place
+ *
+ * EDUCATIONAL NOTE:
+ *   linalg::transform_points(linalg::fixed_rotation_z(angle), xs, ys, zs, n);
+ * replaces n heap allocations and 9n checked accesses with one streaming,
+ * vectorized, multithreaded pass.
+ */
+template<typename T>
+void transform_points(const FixedMatrix<T, 3, 3>& r, T* xs, T* ys, T* zs, size_t n) {
+    detail::transform_points_soa(r, xs, ys, zs, n);
+}
+
+/**
+ * @brief Applies a 4x4 homogeneous transform to n SoA points, in place
+ *
+ * Points are treated as (x, y, z, 1). If the last row of h is not
+ * [0 0 0 1], results are divided by w (perspective projection).
+ */
+template<typename T>
+void transform_points(const FixedMatrix<T, 4, 4>& h, T* xs, T* ys, T* zs, size_t n) {
+    detail::transform_points_soa(h, xs, ys, zs, n);
+}
+
+/**
+ * @brief SoA overloads taking spans of equal length
+ *
+ * @throws std::invalid_argument if the spans differ in length
+ */
+template<typename T, size_t N>
+void transform_points(const FixedMatrix<T, N, N>& m, Span<T> xs, Span<T> ys, Span<T> zs) {
+    static_assert(N == 3 || N == 4, "Point transforms are 3x3 or 4x4");
+    if (xs.size() != ys.size() || xs.size() != zs.size()) {
+        throw std::invalid_argument("Coordinate arrays must have the same length");
+    }
+    detail::transform_points_soa(m, xs.data(), ys.data(), zs.data(), xs.size());
+}
+
+/**
+ * @brief Transforms n interleaved (AoS) points in place
+ *
+ * @param xyz    Point i occupies xyz[i * stride + 0..2]
+ * @param stride Elements between consecutive points: 3 for packed xyz,
+ *               4 for xyzw or padded layouts, or the size of a larger record
+ * @throws std::invalid_argument if stride < 3
+ */
+template<typename T>
+void transform_points(const FixedMatrix<T, 3, 3>& r, T* xyz, size_t n, size_t stride = 3) {
+    detail::transform_points_aos(r, xyz, n, stride);
+}
+
+template<typename T>
+void transform_points(const FixedMatrix<T, 4, 4>& h, T* xyz, size_t n, size_t stride = 3) {
+    detail::transform_points_aos(h, xyz, n, stride);
+}
+
+} // namespace linalg
+
+#endif // TRANSFORM_HPP
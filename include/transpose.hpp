@@ -0,0 +1,292 @@
+#ifndef TRANSPOSE_HPP
+#define TRANSPOSE_HPP
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Blocked matrix transposition, out of place and in place
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Transposing reads A row by row and writes B column by column (or the
+ * other way round): one of the two always jumps a whole row per element.
+ * For a matrix wider than the cache, each of those jumps touches a new
+ * cache line and uses 8 of its 64 bytes, so the naive double loop runs at
+ * a fraction of memory bandwidth.
+ *
+ * Blocking fixes the access pattern:
+ * 1. Cache tiles: B(J, I) = A(I, J)ᵀ one 32x32 tile at a time. A tile of
+ *    the source and one of the destination fit in L1 together, so every
+ *    cache line that is loaded is used completely before it is evicted
+ * 2. Register tiles: inside a cache tile, 4x4 (double) or 8x8 (float)
+ *    blocks are loaded as whole rows into SIMD registers, transposed with
+ *    unpack / shuffle / lane-permute instructions and stored as whole rows
+ * 3. Threads: tiles are independent, so large matrices are split into
+ *    bands of tile rows of B on the thread pool
+ *
+ * IN PLACE:
+ * - Square: tile (I, J) and tile (J, I) are transposed into each other's
+ *   place through a small buffer; diagonal tiles swap across their diagonal
+ * - Rectangular (m x n -> n x m in the same buffer): element k of the
+ *   row-major array moves to position k·m mod (mn - 1). These moves form
+ *   disjoint cycles, which are followed one by one while a bitmap marks
+ *   visited positions. Every access is a cache miss, so this is several
+ *   times slower than out of place; it is for matrices too large to copy
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - The AVX2 kernels are used when simd::active_isa() is AVX2 or AVX-512;
+ *   other types and CPUs use the same blocking with scalar tiles
+ * - Matrices are row-major with a leading dimension, as in gemm.hpp
+ */
+namespace linalg {
+
+/**
+ * @brief Element count from which out-of-place transposes use the thread pool
+ */
+constexpr size_t transpose_parallel_limit = size_t(1) << 18;
+
+namespace detail {
+
+// Edge of a cache tile, in elements
+constexpr size_t transpose_block = 32;
+
+template<typename T>
+using transpose_block_fn = void (*)(size_t, size_t, const T*, size_t, T*, size_t);
+
+/**
+ * @brief B = Aᵀ for one m x n cache tile (scalar)
+ */
+template<typename T>
+void transpose_block_generic(size_t m, size_t n, const T* a, size_t lda, T* b, size_t ldb) {
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            b[j * ldb + i] = a[i * lda + j];
+        }
+    }
+}
+
+#if defined(LINALG_SIMD_X86)
+
+/**
+ * @brief 4x4 doubles: two unpacks pair up rows, a lane permute finishes
+ *
+ *   rows        a0 a1 a2 a3 / b0 b1 b2 b3 / c.. / d..
+ *   unpacklo    a0 b0 a2 b2        unpackhi   a1 b1 a3 b3
+ *   permute     a0 b0 c0 d0 (low lanes)  ...  a2 b2 c2 d2 (high lanes)
+ */
+LINALG_INLINE_AVX2 void transpose_micro(const double* a, size_t lda, double* b, size_t ldb) {
+    const __m256d r0 = _mm256_loadu_pd(a);
+    const __m256d r1 = _mm256_loadu_pd(a + lda);
+    const __m256d r2 = _mm256_loadu_pd(a + 2 * lda);
+    const __m256d r3 = _mm256_loadu_pd(a + 3 * lda);
+    const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+    _mm256_storeu_pd(b, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(b + ldb, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(b + 2 * ldb, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(b + 3 * ldb, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+/**
+ * @brief 8x8 floats: unpack pairs, shuffle quads, permute 128-bit lanes
+ */
+LINALG_INLINE_AVX2 void transpose_micro(const float* a, size_t lda, float* b, size_t ldb) {
+    __m256 r[8];
+    for (size_t k = 0; k < 8; ++k) r[k] = _mm256_loadu_ps(a + k * lda);
+    __m256 t[8];
+    for (size_t k = 0; k < 8; k += 2) {
+        t[k] = _mm256_unpacklo_ps(r[k], r[k + 1]);
+        t[k + 1] = _mm256_unpackhi_ps(r[k], r[k + 1]);
+    }
+    __m256 s[8];
+    for (size_t k = 0; k < 8; k += 4) {
+        s[k] = _mm256_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(1, 0, 1, 0));
+        s[k + 1] = _mm256_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(3, 2, 3, 2));
+        s[k + 2] = _mm256_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(1, 0, 1, 0));
+        s[k + 3] = _mm256_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(3, 2, 3, 2));
+    }
+    for (size_t k = 0; k < 4; ++k) {
+        _mm256_storeu_ps(b + k * ldb, _mm256_permute2f128_ps(s[k], s[k + 4], 0x20));
+        _mm256_storeu_ps(b + (k + 4) * ldb, _mm256_permute2f128_ps(s[k], s[k + 4], 0x31));
+    }
+}
+
+/**
+ * @brief B = Aᵀ for one cache tile from SIMD register tiles, scalar edges
+ */
+template<typename T>
+LINALG_TARGET_AVX2 void transpose_block_avx2(size_t m, size_t n, const T* a, size_t lda, T* b, size_t ldb) {
+    constexpr size_t w = 32 / sizeof(T);  // elements per AVX2 register
+    size_t i = 0;
+    for (; i + w <= m; i += w) {
+        size_t j = 0;
+        for (; j + w <= n; j += w) {
+            transpose_micro(a + i * lda + j, lda, b + j * ldb + i, ldb);
+        }
+        for (; j < n; ++j) {
+            for (size_t k = 0; k < w; ++k) b[j * ldb + i + k] = a[(i + k) * lda + j];
+        }
+    }
+    for (; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) b[j * ldb + i] = a[i * lda + j];
+    }
+}
+
+#endif // LINALG_SIMD_X86
+
+template<typename T>
+transpose_block_fn<T> select_transpose_block() {
+#if defined(LINALG_SIMD_X86)
+    if constexpr (simd::has_kernels<T>) {
+        const simd::isa level = simd::active_isa();
+        if (level == simd::isa::avx2 || level == simd::isa::avx512) return &transpose_block_avx2<T>;
+    }
+#endif
+    return &transpose_block_generic<T>;
+}
+
+/**
+ * @brief Fills tile row [j0, j1) of B from the matching tile columns of A
+ */
+template<typename T>
+void transpose_band(transpose_block_fn<T> block, size_t j0, size_t j1, size_t m,
+                    const T* a, size_t lda, T* b, size_t ldb) {
+    for (size_t i0 = 0; i0 < m; i0 += transpose_block) {
+        const size_t ni = std::min(transpose_block, m - i0);
+        block(ni, j1 - j0, a + i0 * lda + j0, lda, b + j0 * ldb + i0, ldb);
+    }
+}
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 uint128;  // GCC/Clang builtin, not ISO C++
+#endif
+
+// (p * m) mod size without overflow for any p, m < size
+inline size_t mul_mod(size_t p, size_t m, size_t size) {
+    // Below 2^(bits/2) elements (2^32 for 64-bit size_t) the product fits
+    if (size <= size_t(1) << (4 * sizeof(size_t))) return p * m % size;
+#if defined(__SIZEOF_INT128__)
+    return static_cast<size_t>(static_cast<uint128>(p) * m % size);
+#else
+    size_t result = 0;
+    p %= size;
+    for (; m; m >>= 1) {
+        if (m & 1) result = (result >= size - p) ? result - (size - p) : result + p;
+        p = (p >= size - p) ? p - (size - p) : p + p;
+    }
+    return result;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief B = Aᵀ, A is m x n with leading dimension lda, B is n x m with ldb
+ *
+ * A and B must not overlap.
+ */
+template<typename T>
+void transpose(size_t m, size_t n, const T* a, size_t lda, T* b, size_t ldb) {
+    if (m == 0 || n == 0) return;
+    const detail::transpose_block_fn<T> block = detail::select_transpose_block<T>();
+    constexpr size_t tile = detail::transpose_block;
+    const size_t bands = (n + tile - 1) / tile;
+
+    // Each band is one tile row of B: its stores stream through consecutive
+    // rows while the loads hop down A, which measured faster than the
+    // reverse order once the matrix leaves L2
+    auto band = [&](size_t J) {
+        const size_t j0 = J * tile;
+        detail::transpose_band(block, j0, std::min(n, j0 + tile), m, a, lda, b, ldb);
+    };
+
+    ThreadPool& pool = default_thread_pool();
+    if (m * n < transpose_parallel_limit || pool.num_threads() == 1 || bands == 1) {
+        for (size_t J = 0; J < bands; ++J) band(J);
+        return;
+    }
+    pool.parallel_for(bands, band);
+}
+
+/**
+ * @brief A = Aᵀ for a square n x n matrix with leading dimension lda
+ */
+template<typename T>
+void transpose_in_place(size_t n, T* a, size_t lda) {
+    const detail::transpose_block_fn<T> block = detail::select_transpose_block<T>();
+    constexpr size_t tile = detail::transpose_block;
+    const size_t tiles = (n + tile - 1) / tile;
+
+    // Tile row I swaps with tile column I; rows are independent tasks
+    auto tile_row = [&](size_t I) {
+        const size_t i0 = I * tile;
+        const size_t ni = std::min(tile, n - i0);
+        for (size_t i = 0; i < ni; ++i) {
+            for (size_t j = i + 1; j < ni; ++j) {
+                std::swap(a[(i0 + i) * lda + i0 + j], a[(i0 + j) * lda + i0 + i]);
+            }
+        }
+        T buffer[tile * tile];
+        for (size_t j0 = i0 + tile; j0 < n; j0 += tile) {
+            const size_t nj = std::min(tile, n - j0);
+            T* upper = a + i0 * lda + j0;  // ni x nj
+            T* lower = a + j0 * lda + i0;  // nj x ni
+            block(ni, nj, upper, lda, buffer, ni);  // buffer = upperᵀ
+            block(nj, ni, lower, lda, upper, lda);  // upper = lowerᵀ
+            for (size_t r = 0; r < nj; ++r) {
+                std::copy(buffer + r * ni, buffer + (r + 1) * ni, lower + r * lda);
+            }
+        }
+    };
+
+    ThreadPool& pool = default_thread_pool();
+    if (n * n < transpose_parallel_limit || pool.num_threads() == 1) {
+        for (size_t I = 0; I < tiles; ++I) tile_row(I);
+        return;
+    }
+    pool.parallel_for(tiles, tile_row);
+}
+
+/**
+ * @brief Rearranges a contiguous m x n row-major matrix into its n x m transpose
+ *
+ * EDUCATIONAL NOTE:
+ * Element (i, j) sits at k = i·n + j and belongs at j·m + i. Since
+ * m·n ≡ 1 (mod mn - 1), that destination is simply k·m mod (mn - 1).
+ * Starting from each position not yet visited, the element there is
+ * carried along its cycle, displacing the next one, until the cycle
+ * closes. Extra memory: one bit per element.
+ */
+template<typename T>
+void transpose_in_place(size_t m, size_t n, T* a) {
+    if (m == n) {
+        transpose_in_place(n, a, n);
+        return;
+    }
+    if (m <= 1 || n <= 1) return;  // a single row or column has the same layout
+
+    const size_t size = m * n - 1;  // positions 0 and mn - 1 never move
+    std::vector<bool> visited(size, false);
+    for (size_t start = 1; start < size; ++start) {
+        if (visited[start]) continue;
+        T carried = std::move(a[start]);
+        size_t position = start;
+        do {
+            position = detail::mul_mod(position, m, size);
+            std::swap(carried, a[position]);
+            visited[position] = true;
+        } while (position != start);
+    }
+}
+
+} // namespace linalg
+
+#endif // TRANSPOSE_HPP
@@ -0,0 +1,133 @@
+#ifndef TRSM_HPP
+#define TRSM_HPP
+
+#include "gemm.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+
+/**
+ * @brief Blocked triangular solves with many right-hand sides (TRSM)
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * Solving L·X = B for a triangular L and an m x n block B is the level-3
+ * (matrix-matrix) version of forward substitution. Splitting L into blocks
+ *
+ *   [L11  0 ] [X1]   [B1]        X1 = L11⁻¹ B1            (small solve)
+ *   [L21 L22] [X2] = [B2]   =>   B2 = B2 - L21·X1         (GEMM)
+ *                                X2 = L22⁻¹ B2            (recurse)
+ *
+ * moves almost all flops into GEMM, which runs near machine peak.
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - Row-major storage with leading dimensions, like gemm.hpp
+ * - Columns of B are independent, so large solves are split into column
+ *   chunks and run on the thread pool
+ */
+namespace linalg {
+
+/**
+ * @brief Diagonal block size of the blocked triangular solves
+ */
+constexpr size_t trsm_block_size = 64;
+
+namespace detail {
+
+/**
+ * @brief B := L⁻¹·B, L unit lower triangular (m x m), B m x n
+ */
+template<typename T>
+void trsm_left_lower_unit_serial(size_t m, size_t n, const T* l, size_t ldl, T* b, size_t ldb) {
+    for (size_t i0 = 0; i0 < m; i0 += trsm_block_size) {
+        const size_t ib = std::min(trsm_block_size, m - i0);
+        for (size_t i = i0 + 1; i < i0 + ib; ++i) {
+            for (size_t p = i0; p < i; ++p) {
+                const T lip = l[i * ldl + p];
+                if (lip != T(0)) simd::axpy(n, -lip, b + p * ldb, b + i * ldb);
+            }
+        }
+        if (i0 + ib < m) {
+            gemm_serial(m - i0 - ib, n, ib, T(-1), l + (i0 + ib) * ldl + i0, ldl, size_t(1),
+                        b + i0 * ldb, ldb, size_t(1), T(1), b + (i0 + ib) * ldb, ldb, size_t(1));
+        }
+    }
+}
+
+/**
+ * @brief B := U⁻¹·B, U upper triangular with non-unit diagonal (m x m)
+ */
+template<typename T>
+void trsm_left_upper_serial(size_t m, size_t n, const T* u, size_t ldu, T* b, size_t ldb) {
+    for (size_t end = m; end > 0;) {
+        const size_t i0 = end > trsm_block_size ? end - trsm_block_size : 0;
+        for (size_t i = end; i-- > i0;) {
+            for (size_t p = i + 1; p < end; ++p) {
+                const T uip = u[i * ldu + p];
+                if (uip != T(0)) simd::axpy(n, -uip, b + p * ldb, b + i * ldb);
+            }
+            simd::scal(n, T(1) / u[i * ldu + i], b + i * ldb);
+        }
+        if (i0 > 0) {
+            gemm_serial(i0, n, end - i0, T(-1), u + i0, ldu, size_t(1),
+                        b + i0 * ldb, ldb, size_t(1), T(1), b, ldb, size_t(1));
+        }
+        end = i0;
+    }
+}
+
+/**
+ * @brief Runs fn(first_column, column_count) over chunks of n columns,
+ * in parallel when the solve (about m² n multiply-adds) is large enough
+ */
+template<typename F>
+void for_column_chunks(size_t m, size_t n, F&& fn) {
+    ThreadPool& pool = default_thread_pool();
+    const size_t threads = pool.num_threads();
+    if (threads == 1 || m * m * n < gemm_parallel_limit || n < 128) {
+        fn(size_t(0), n);
+        return;
+    }
+    const size_t chunk = std::max<size_t>(64, (n / (4 * threads) + 15) / 16 * 16);
+    const size_t chunks = (n + chunk - 1) / chunk;
+    pool.parallel_for(chunks, [&](size_t c) {
+        const size_t j0 = c * chunk;
+        fn(j0, std::min(chunk, n - j0));
+    });
+}
+
+} // namespace detail
+
+/**
+ * @brief Solves L·X = B in place (B is overwritten with X)
+ *
+ * @param l Unit lower triangular m x m matrix (its diagonal and upper part
+ *          are not referenced)
+ * @param b m x n right-hand sides, row-major with leading dimension ldb
+ */
+template<typename T>
+void trsm_left_lower_unit(size_t m, size_t n, const T* l, size_t ldl, T* b, size_t ldb) {
+    if (m == 0 || n == 0) return;
+    detail::for_column_chunks(m, n, [&](size_t j0, size_t nj) {
+        detail::trsm_left_lower_unit_serial(m, nj, l, ldl, b + j0, ldb);
+    });
+}
+
+/**
+ * @brief Solves U·X = B in place (B is overwritten with X)
+ *
+ * @param u Upper triangular m x m matrix with non-zero diagonal (the strict
+ *          lower part is not referenced)
+ */
+template<typename T>
+void trsm_left_upper(size_t m, size_t n, const T* u, size_t ldu, T* b, size_t ldb) {
+    if (m == 0 || n == 0) return;
+    detail::for_column_chunks(m, n, [&](size_t j0, size_t nj) {
+        detail::trsm_left_upper_serial(m, nj, u, ldu, b + j0, ldb);
+    });
+}
+
+} // namespace linalg
+
+#endif // TRSM_HPP
@@ -3,7 +3,12 @@
 #define VECTOR_HPP
 
 #include "matrix.hpp"
+#include "gemv.hpp"
+#include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <limits>
+#include <memory>
 
 /**
  * @brief Template class for mathematical vectors
@@ -29,19 +34,86 @@
  * 
  * IMPLEMENTATION DETAILS:
  * ----------------------
- * - Inherits matrix functionality
- * - Specializes for 1×n or n×1 matrices
- * - Provides vector-specific operations
+ * - One contiguous buffer of components; orientation is just a flag
+ * - Small-buffer optimization: short vectors (up to 32 bytes, e.g. a 3D or
+ *   homogeneous point of doubles) live inside the object, with no heap
+ *   allocation at all
+ * - Longer vectors use a 64-byte aligned heap buffer, so SIMD loads never
+ *   straddle a cache line at the start of the vector; like Matrix buffers
+ *   it follows the storage policy and the current arena (storage.hpp)
+ * - dot, norm and axpy run on the dispatched SIMD kernels (simd.hpp)
  * 
  * @tparam T The data type of vector elements
  */
 template<typename T>
-class Vector {
+class Vector : public linalg::Expression<Vector<T>> {
 private:
-    Matrix<T> data;  // Vector is implemented as a special case of matrix
+    // Components that fit in the object itself (small-buffer optimization)
+    static constexpr size_t inline_capacity = sizeof(T) >= 32 ? 1 : 32 / sizeof(T);
+    static constexpr size_t heap_alignment = 64;
+
+    alignas(32) T inline_elements[inline_capacity];
+    T* elements;     // inline_elements or heap.get()
+    linalg::storage_ptr<T> heap;
+    size_t length;
     bool is_column;  // Tracks vector orientation
 
+    bool is_inline() const noexcept { return elements == inline_elements; }
+
+    /**
+     * @brief Points elements at storage for n value-initialized components
+     */
+    void allocate(size_t n) {
+        length = n;
+        if (n <= inline_capacity) {
+            elements = inline_elements;
+            std::fill(inline_elements, inline_elements + n, T());
+            return;
+        }
+        linalg::StoragePolicy policy = linalg::default_storage_policy();
+        policy.alignment = std::max(policy.alignment, heap_alignment);
+        heap = linalg::allocate_storage<T>(n, policy, true);
+        elements = heap.get();
+    }
+
+    void release() noexcept {
+        heap.reset();
+        elements = inline_elements;
+        length = 0;
+    }
+
+    // Changes the length on assignment; this vector may predate an open
+    // ArenaScope, so the new buffer comes from the system (see storage.hpp)
+    void reallocate(size_t n) {
+        release();
+        linalg::SystemAllocationScope system;
+        allocate(n);
+    }
+
+    template<typename E>
+    static size_t expression_size(const E& e) {
+        if (e.get_cols() != 1) {
+            throw std::invalid_argument("Expression does not have the shape of a vector");
+        }
+        return e.get_rows();
+    }
+
+    template<typename E>
+    bool reads_shifted(const E& e) const {
+        return e.overlaps(elements, elements + length);
+    }
+
+    template<typename E>
+    void check_same_size(const E& e) const {
+        if (expression_size(e) != length) {
+            throw std::invalid_argument("Vector dimensions mismatch for elementwise operation");
+        }
+    }
+
 public:
+    using value_type = T;
+    static constexpr bool is_leaf = true;  // held by reference inside expressions
+
     /**
      * @brief Construct a column vector
      * 
@@ -51,7 +123,153 @@ public:
      * 2. Matches mathematical notation
      * 3. Simplifies transformation operations
      */
-    explicit Vector(size_t size) : data(size, 1), is_column(true) {}
+    explicit Vector(size_t size) : elements(inline_elements), length(0), is_column(true) {
+        if (size == 0) {
+            throw std::invalid_argument("Vector dimension must be positive");
+        }
+        allocate(size);
+    }
+
+    Vector(const Vector& other) : elements(inline_elements), length(0), is_column(other.is_column) {
+        allocate(other.length);
+        std::copy(other.elements, other.elements + length, elements);
+    }
+
+    /**
+     * @brief Move constructor
+     * 
+     * EDUCATIONAL NOTE:
+     * A heap buffer is handed over by pointer. Inline components have to be
+     * copied, which is cheap because there are at most a few of them. An
+     * arena buffer is copied into system memory, as for Matrix.
+     */
+    Vector(Vector&& other) noexcept : elements(inline_elements), length(other.length), is_column(other.is_column) {
+        if (other.is_inline()) {
+            std::move(other.inline_elements, other.inline_elements + length, inline_elements);
+        } else if (linalg::from_arena(other.heap)) {
+            {
+                linalg::SystemAllocationScope system;
+                allocate(length);
+            }
+            std::copy(other.elements, other.elements + length, elements);
+            other.release();
+        } else {
+            heap = std::move(other.heap);
+            elements = heap.get();
+            other.elements = other.inline_elements;
+        }
+        other.length = 0;
+    }
+
+    Vector& operator=(const Vector& other) {
+        if (this != &other) {
+            if (length != other.length) {
+                reallocate(other.length);
+            }
+            std::copy(other.elements, other.elements + length, elements);
+            is_column = other.is_column;
+        }
+        return *this;
+    }
+
+    // Arena buffers are copied, not adopted, as for Matrix
+    Vector& operator=(Vector&& other) {
+        if (linalg::from_arena(other.heap)) {
+            return *this = static_cast<const Vector&>(other);
+        }
+        if (this != &other) {
+            release();
+            length = other.length;
+            if (other.is_inline()) {
+                std::move(other.inline_elements, other.inline_elements + length, inline_elements);
+            } else {
+                heap = std::move(other.heap);
+                elements = heap.get();
+                other.elements = other.inline_elements;
+            }
+            is_column = other.is_column;
+            other.length = 0;
+        }
+        return *this;
+    }
+
+    ~Vector() { release(); }
+
+    /**
+     * @brief Evaluates an elementwise expression, e.g. Vector<double> w = u + 2.0 * v;
+     * 
+     * EDUCATIONAL NOTE:
+     * Like Matrix, the whole right-hand side is computed in one fused pass
+     * (see expression.hpp). Inside expressions a vector of n components
+     * behaves as an n×1 matrix.
+     */
+    template<typename E>
+    Vector(const linalg::Expression<E>& expr) : elements(inline_elements), length(0), is_column(true) {
+        allocate(expression_size(expr.self()));
+        if constexpr (linalg::detail::is_vector_view<E>::value) {
+            is_column = expr.self().is_column_vector();
+        }
+        linalg::detail::evaluate(elements, length, expr.self(), linalg::detail::Assign<T>());
+    }
+
+    /**
+     * @brief Assigns an elementwise expression
+     * 
+     * A view that reads this vector's components at other positions is
+     * evaluated into a temporary first (see Matrix::operator=).
+     */
+    template<typename E>
+    Vector& operator=(const linalg::Expression<E>& expr) {
+        const E& e = expr.self();
+        if (reads_shifted(e)) {
+            return *this = Vector(e);
+        }
+        const size_t n = expression_size(e);
+        if (n != length) {
+            reallocate(n);
+        }
+        if constexpr (linalg::detail::is_vector_view<E>::value) {
+            is_column = e.is_column_vector();
+        }
+        linalg::detail::evaluate(elements, length, e, linalg::detail::Assign<T>());
+        return *this;
+    }
+
+    template<typename E>
+    Vector& operator+=(const linalg::Expression<E>& expr) {
+        check_same_size(expr.self());
+        if (reads_shifted(expr.self())) {
+            return *this += Vector(expr.self());
+        }
+        linalg::detail::evaluate(elements, length, expr.self(), linalg::detail::Add<T>());
+        return *this;
+    }
+
+    template<typename E>
+    Vector& operator-=(const linalg::Expression<E>& expr) {
+        check_same_size(expr.self());
+        if (reads_shifted(expr.self())) {
+            return *this -= Vector(expr.self());
+        }
+        linalg::detail::evaluate(elements, length, expr.self(), linalg::detail::Subtract<T>());
+        return *this;
+    }
+
+    // Expression interface: n×1 shape and linear element access
+    size_t get_rows() const { return length; }
+    size_t get_cols() const { return 1; }
+    const T& coeff(size_t idx) const noexcept { return elements[idx]; }
+    bool overlaps(const void*, const void*) const noexcept { return false; }
+
+    bool is_column_vector() const noexcept { return is_column; }
+
+    /**
+     * @brief Strided view of the components (see view.hpp)
+     */
+    linalg::VectorView<T> view() noexcept { return linalg::VectorView<T>(elements, length, 1, is_column); }
+    linalg::VectorView<const T> view() const noexcept {
+        return linalg::VectorView<const T>(elements, length, 1, is_column);
+    }
 
     /**
      * @brief Convert between row and column vectors
@@ -60,16 +278,12 @@ public:
      * Transpose operation:
      * 1. Changes orientation (row ↔ column)
      * 2. Preserves vector elements
-     * 3. Useful for certain computations
+     * 3. Costs O(1): the result is a view of the same components with the
+     *    orientation flag flipped. Vector<T> r = v.transpose(); makes an
+     *    independent copy when one is needed.
      */
-    Vector<T> transpose() const {
-        Vector<T> result(data.get_rows());
-        for (size_t i = 0; i < data.get_rows(); ++i) {
-            result.data.at(i, 0) = data.at(i, 0);
-        }
-        result.is_column = !is_column;
-        return result;
-    }
+    linalg::VectorView<T> transpose() noexcept { return view().transpose(); }
+    linalg::VectorView<const T> transpose() const noexcept { return view().transpose(); }
 
     /**
      * @brief Vector dot product
@@ -89,15 +303,11 @@ public:
      * - Angle calculations
      */
     T dot(const Vector<T>& other) const {
-        if (data.get_rows() != other.data.get_rows()) {
+        if (length != other.length) {
             throw std::invalid_argument("Vectors must have same dimension for dot product");
         }
-
-        T result = T();
-        for (size_t i = 0; i < data.get_rows(); ++i) {
-            result += data.at(i, 0) * other.data.at(i, 0);
-        }
-        return result;
+        // float and double use the SIMD kernel selected at start-up
+        return linalg::simd::dot(length, elements, other.elements);
     }
 
     /**
@@ -116,20 +326,92 @@ public:
      * - Distance calculations
      * - Vector normalization
      * - Error metrics
+     * 
+     * NUMERICAL NOTE:
+     * Squaring can overflow even when the norm itself is representable:
+     * for v = (1e200, 1e200), v·v = 2e400 is infinite in double precision.
+     * Tiny components underflow to zero the same way. Like BLAS nrm2, the
+     * norm is then computed as s·||v/s|| with s = max|v_i|, which keeps
+     * every square in [0, n]. The common case pays nothing extra: the
+     * fast SIMD v·v is used whenever it is safely inside the normal range.
      */
     T norm() const {
-        return std::sqrt(dot(*this));
+        const T sum_of_squares = dot(*this);
+        if constexpr (std::is_floating_point_v<T>) {
+            constexpr T safe_min = std::numeric_limits<T>::min() / std::numeric_limits<T>::epsilon();
+            if (sum_of_squares >= safe_min && sum_of_squares <= std::numeric_limits<T>::max()) {
+                return std::sqrt(sum_of_squares);
+            }
+            if (std::isnan(sum_of_squares)) return sum_of_squares;
+
+            T scale = T(0);
+            for (size_t i = 0; i < length; ++i) scale = std::max(scale, std::abs(elements[i]));
+            if (scale == T(0) || std::isinf(scale)) return scale;
+
+            T scaled = T(0);
+            for (size_t i = 0; i < length; ++i) {
+                const T t = elements[i] / scale;
+                scaled += t * t;
+            }
+            return scale * std::sqrt(scaled);
+        } else {
+            return std::sqrt(sum_of_squares);
+        }
+    }
+
+    /**
+     * @brief this := this + alpha·x, in one SIMD pass (BLAS axpy)
+     * 
+     * @throws std::invalid_argument if the sizes differ
+     */
+    Vector& axpy(T alpha, const Vector<T>& x) {
+        if (length != x.length) {
+            throw std::invalid_argument("Vectors must have same dimension for axpy");
+        }
+        linalg::simd::axpy(length, alpha, x.elements, elements);
+        return *this;
     }
 
     // Element access with bounds checking
     T& at(size_t i) {
-        return data.at(i, 0);
+        if (i >= length) {
+            throw std::out_of_range("Vector index out of bounds");
+        }
+        return elements[i];
     }
 
     const T& at(size_t i) const {
-        return data.at(i, 0);
+        if (i >= length) {
+            throw std::out_of_range("Vector index out of bounds");
+        }
+        return elements[i];
+    }
+
+    // Unchecked element access (asserted in debug builds)
+    T& operator[](size_t i) noexcept {
+        assert(i < length);
+        return elements[i];
+    }
+
+    const T& operator[](size_t i) const noexcept {
+        assert(i < length);
+        return elements[i];
     }
 
+    /**
+     * @brief Contiguous storage of the components
+     * 
+     * EDUCATIONAL NOTE:
+     * Components are stored back to back whatever the orientation, so
+     * data()[i] is component i and the stride between components is 1.
+     */
+    T* data() noexcept { return elements; }
+    const T* data() const noexcept { return elements; }
+    size_t stride() const noexcept { return 1; }
+
+    linalg::Span<T> span() noexcept { return linalg::Span<T>(elements, length); }
+    linalg::Span<const T> span() const noexcept { return linalg::Span<const T>(elements, length); }
+
     /**
      * @brief Get vector dimension
      * 
@@ -140,8 +422,64 @@ public:
      * 3. Must match for operations
      */
     size_t size() const {
-        return data.get_rows();
+        return length;
     }
 };
 
+namespace linalg {
+
+/**
+ * @brief y := alpha·A·x + beta·y on Matrix / Vector storage (no copies)
+ * 
+ * @throws std::invalid_argument on dimension mismatch or if y aliases x
+ */
+template<typename T>
+void gemv(T alpha, const Matrix<T>& A, const Vector<T>& x, T beta, Vector<T>& y) {
+    if (A.get_cols() != x.size() || A.get_rows() != y.size()) {
+        throw std::invalid_argument("Matrix and vector dimensions mismatch for multiplication");
+    }
+    if (x.data() == y.data()) {
+        throw std::invalid_argument("Output vector must not alias the input vector");
+    }
+    gemv(A.get_rows(), A.get_cols(), alpha, A.data(), A.row_stride(), x.data(), beta, y.data());
+}
+
+/**
+ * @brief y := alpha·Aᵀ·x + beta·y without forming Aᵀ
+ * 
+ * @throws std::invalid_argument on dimension mismatch or if y aliases x
+ */
+template<typename T>
+void gemv_transposed(T alpha, const Matrix<T>& A, const Vector<T>& x, T beta, Vector<T>& y) {
+    if (A.get_rows() != x.size() || A.get_cols() != y.size()) {
+        throw std::invalid_argument("Matrix and vector dimensions mismatch for multiplication");
+    }
+    if (x.data() == y.data()) {
+        throw std::invalid_argument("Output vector must not alias the input vector");
+    }
+    gemv_transposed(A.get_rows(), A.get_cols(), alpha, A.data(), A.row_stride(), x.data(), beta, y.data());
+}
+
+} // namespace linalg
+
+/**
+ * @brief Matrix-vector product A·x
+ * 
+ * EDUCATIONAL NOTE:
+ * Multiplying by a vector is a GEMV, not a GEMM with a one-column matrix:
+ * it streams each row of A once through a SIMD dot product (in parallel
+ * for large A), with no packing and no conversion of x into a Matrix.
+ * 
+ * @throws std::invalid_argument if A.get_cols() != x.size()
+ */
+template<typename T>
+Vector<T> operator*(const Matrix<T>& A, const Vector<T>& x) {
+    if (A.get_cols() != x.size()) {
+        throw std::invalid_argument("Matrix and vector dimensions mismatch for multiplication");
+    }
+    Vector<T> y(A.get_rows());
+    linalg::gemv(A.get_rows(), A.get_cols(), T(1), A.data(), A.row_stride(), x.data(), T(0), y.data());
+    return y;
+}
+
 #endif // VECTOR_HPP
@@ -0,0 +1,411 @@
+#ifndef VIEW_HPP
+#define VIEW_HPP
+
+#include "expression.hpp"
+#include "gemm.hpp"
+#include "gemv.hpp"
+#include "simd.hpp"
+#include "transpose.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief Non-owning strided views of matrices and vectors
+ *
+ * EDUCATIONAL NOTES:
+ * ==================
+ * A row-major matrix stores element (i, j) at data[i * ld + j]. Generalize
+ * that to data[i * row_stride + j * col_stride] and a pointer, two sizes and
+ * two strides describe much more than "the whole matrix":
+ *
+ *   submatrix A(r0.., c0..)   pointer + r0 * ld + c0, same strides
+ *   row i                     pointer + i * ld, stride 1
+ *   column j                  pointer + j, stride ld
+ *   transpose Aᵀ              same pointer, rows/cols and strides swapped
+ *
+ * None of these copies an element: they cost O(1) instead of an allocation
+ * plus O(n²) copy. This is how BLAS and LAPACK pass submatrices (a pointer
+ * plus a leading dimension), and how blocked algorithms extract panels.
+ *
+ * KEY CONCEPTS:
+ * -------------
+ * 1. Ownership: a view borrows its elements; it must not outlive the matrix
+ *    or vector it was taken from, and resizing that object invalidates it
+ * 2. Constness: MatrixView<const T> only reads, MatrixView<T> may write;
+ *    a mutable view converts to a const one implicitly
+ * 3. Kernels: gemm, gemv, dot and axpy below take views directly and pick
+ *    the SIMD path whenever the strides allow it
+ *
+ * IMPLEMENTATION DETAILS:
+ * ---------------------
+ * - Views are expressions, so `Matrix<double> C = A.view().transpose() + B;`
+ *   and `view.assign(2.0 * B)` work like their Matrix counterparts
+ * - Views are copied into expression nodes (they are a few words), so an
+ *   expression built from temporary views does not dangle
+ * - Copying one view into another picks row copies or the blocked
+ *   transpose of transpose.hpp from the strides, so materializing
+ *   `Matrix<double> At = A.transpose();` runs near memcpy speed
+ * - view.assign(expr) writes element by element; if expr reads the viewed
+ *   elements at other positions (e.g. a transposed view of the same
+ *   storage) the result is unspecified
+ */
+namespace linalg {
+
+template<typename T>
+class VectorView;
+
+namespace detail {
+
+// [a, a_end) and [b, b_end) share an address (std::less orders any pointers)
+inline bool ranges_overlap(const void* a, const void* a_end, const void* b, const void* b_end) {
+    const std::less<const void*> before;
+    return before(a, b_end) && before(b, a_end);
+}
+
+} // namespace detail
+
+template<typename T>
+class MatrixView : public Expression<MatrixView<T>> {
+private:
+    T* elements;
+    size_t rows;
+    size_t cols;
+    size_t rs;  // distance between (i, j) and (i + 1, j)
+    size_t cs;  // distance between (i, j) and (i, j + 1)
+
+public:
+    using value_type = std::remove_const_t<T>;
+    static constexpr bool is_leaf = false;
+
+    MatrixView(T* data, size_t r, size_t c, size_t row_stride, size_t col_stride = 1)
+        : elements(data), rows(r), cols(c), rs(row_stride), cs(col_stride) {}
+
+    // A writable view can always be used where a read-only one is expected
+    template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+    MatrixView(const MatrixView<U>& other)
+        : MatrixView(other.data(), other.get_rows(), other.get_cols(), other.row_stride(), other.col_stride()) {}
+
+    size_t get_rows() const noexcept { return rows; }
+    size_t get_cols() const noexcept { return cols; }
+    size_t row_stride() const noexcept { return rs; }
+    size_t col_stride() const noexcept { return cs; }
+    T* data() const noexcept { return elements; }
+
+    // Rows are contiguous and packed back to back, as in a whole Matrix
+    bool is_contiguous() const noexcept { return cs == 1 && (rs == cols || rows == 1); }
+
+    // Unchecked access (asserted in debug builds)
+    T& operator()(size_t i, size_t j) const {
+        assert(i < rows && j < cols);
+        return elements[i * rs + j * cs];
+    }
+
+    T& at(size_t i, size_t j) const {
+        if (i >= rows || j >= cols) {
+            throw std::out_of_range("Matrix index out of bounds");
+        }
+        return elements[i * rs + j * cs];
+    }
+
+    // Expression interface: idx-th element in row-major order
+    value_type coeff(size_t idx) const {
+        return elements[(idx / cols) * rs + (idx % cols) * cs];
+    }
+
+    // Conservative: any overlap of the viewed range counts
+    bool overlaps(const void* first, const void* last) const {
+        if (rows == 0 || cols == 0) return false;
+        return detail::ranges_overlap(elements, elements + (rows - 1) * rs + (cols - 1) * cs + 1, first, last);
+    }
+
+    /**
+     * @brief Aᵀ as a view: swaps the sizes and the strides, copies nothing
+     */
+    MatrixView transpose() const noexcept { return MatrixView(elements, cols, rows, cs, rs); }
+
+    /**
+     * @brief The nr x nc submatrix whose top-left element is (r0, c0)
+     *
+     * @throws std::out_of_range if the block does not fit inside the view
+     */
+    MatrixView block(size_t r0, size_t c0, size_t nr, size_t nc) const {
+        if (r0 > rows || c0 > cols || nr > rows - r0 || nc > cols - c0) {
+            throw std::out_of_range("Block exceeds matrix bounds");
+        }
+        return MatrixView(elements + r0 * rs + c0 * cs, nr, nc, rs, cs);
+    }
+
+    VectorView<T> row(size_t i) const;
+    VectorView<T> col(size_t j) const;
+
+    /**
+     * @brief Overwrites the viewed elements with an expression of the same shape
+     *
+     * @throws std::invalid_argument on shape mismatch
+     */
+    template<typename E>
+    const MatrixView& assign(const Expression<E>& expr) const {
+        static_assert(!std::is_const_v<T>, "Cannot assign through a read-only view");
+        const E& e = expr.self();
+        if (e.get_rows() != rows || e.get_cols() != cols) {
+            throw std::invalid_argument("Matrix dimensions mismatch for elementwise operation");
+        }
+        if constexpr (std::is_same_v<E, MatrixView<value_type>> || std::is_same_v<E, MatrixView<const value_type>>) {
+            copy_from(e);
+            return *this;
+        }
+        if (is_contiguous()) {
+            detail::evaluate(elements, rows * cols, e, detail::Assign<value_type>());
+            return *this;
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                elements[i * rs + j * cs] = e.coeff(i * cols + j);
+            }
+        }
+        return *this;
+    }
+
+private:
+    /**
+     * @brief Copies a view of the same shape, choosing the kernel from the strides
+     */
+    template<typename U>
+    void copy_from(const MatrixView<U>& src) const {
+        if (cs == 1 && src.col_stride() == 1) {
+            for (size_t i = 0; i < rows; ++i) {
+                std::copy(src.data() + i * src.row_stride(), src.data() + i * src.row_stride() + cols,
+                          elements + i * rs);
+            }
+        } else if (cs == 1 && src.row_stride() == 1) {
+            // src is the transpose of a cols x rows row-major block
+            linalg::transpose(cols, rows, src.data(), src.col_stride(), elements, rs);
+        } else {
+            for (size_t i = 0; i < rows; ++i) {
+                for (size_t j = 0; j < cols; ++j) elements[i * rs + j * cs] = src(i, j);
+            }
+        }
+    }
+};
+
+template<typename T>
+class VectorView : public Expression<VectorView<T>> {
+private:
+    T* elements;
+    size_t length;
+    size_t step;
+    bool column;
+
+public:
+    using value_type = std::remove_const_t<T>;
+    static constexpr bool is_leaf = false;
+
+    VectorView(T* data, size_t n, size_t stride = 1, bool is_column = true)
+        : elements(data), length(n), step(stride), column(is_column) {}
+
+    template<typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+    VectorView(const VectorView<U>& other)
+        : VectorView(other.data(), other.size(), other.stride(), other.is_column_vector()) {}
+
+    size_t size() const noexcept { return length; }
+    size_t stride() const noexcept { return step; }
+    T* data() const noexcept { return elements; }
+    bool is_column_vector() const noexcept { return column; }
+
+    // Expression interface: n×1, like Vector
+    size_t get_rows() const noexcept { return length; }
+    size_t get_cols() const noexcept { return 1; }
+    value_type coeff(size_t idx) const { return elements[idx * step]; }
+
+    bool overlaps(const void* first, const void* last) const {
+        if (length == 0) return false;
+        return detail::ranges_overlap(elements, elements + (length - 1) * step + 1, first, last);
+    }
+
+    T& operator[](size_t i) const {
+        assert(i < length);
+        return elements[i * step];
+    }
+
+    T& at(size_t i) const {
+        if (i >= length) {
+            throw std::out_of_range("Vector index out of bounds");
+        }
+        return elements[i * step];
+    }
+
+    /**
+     * @brief The same elements with the opposite orientation, in O(1)
+     */
+    VectorView transpose() const noexcept { return VectorView(elements, length, step, !column); }
+
+    /**
+     * @brief The n elements starting at element first
+     *
+     * @throws std::out_of_range if they do not fit inside the view
+     */
+    VectorView segment(size_t first, size_t n) const {
+        if (first > length || n > length - first) {
+            throw std::out_of_range("Segment exceeds vector bounds");
+        }
+        return VectorView(elements + first * step, n, step, column);
+    }
+
+    template<typename E>
+    const VectorView& assign(const Expression<E>& expr) const {
+        static_assert(!std::is_const_v<T>, "Cannot assign through a read-only view");
+        const E& e = expr.self();
+        if (e.get_rows() != length || e.get_cols() != 1) {
+            throw std::invalid_argument("Vector dimensions mismatch for elementwise operation");
+        }
+        if (step == 1) {
+            detail::evaluate(elements, length, e, detail::Assign<value_type>());
+            return *this;
+        }
+        for (size_t i = 0; i < length; ++i) elements[i * step] = e.coeff(i);
+        return *this;
+    }
+};
+
+namespace detail {
+
+template<typename E>
+struct is_vector_view : std::false_type {};
+
+template<typename E>
+struct is_matrix_view : std::false_type {};
+
+template<typename T>
+struct is_matrix_view<MatrixView<T>> : std::true_type {};
+
+template<typename T>
+struct is_vector_view<VectorView<T>> : std::true_type {};
+
+} // namespace detail
+
+template<typename T>
+VectorView<T> MatrixView<T>::row(size_t i) const {
+    if (i >= rows) throw std::out_of_range("Row index out of bounds");
+    return VectorView<T>(elements + i * rs, cols, cs, false);
+}
+
+template<typename T>
+VectorView<T> MatrixView<T>::col(size_t j) const {
+    if (j >= cols) throw std::out_of_range("Column index out of bounds");
+    return VectorView<T>(elements + j * cs, rows, rs, true);
+}
+
+/**
+ * @brief x·y over two views; the SIMD kernel is used when both are contiguous
+ */
+template<typename T, typename U>
+std::remove_const_t<T> dot(const VectorView<T>& x, const VectorView<U>& y) {
+    using V = std::remove_const_t<T>;
+    static_assert(std::is_same_v<V, std::remove_const_t<U>>, "Views must have the same element type");
+    if (x.size() != y.size()) {
+        throw std::invalid_argument("Vectors must have same dimension for dot product");
+    }
+    if constexpr (simd::has_kernels<V>) {
+        if (x.stride() == 1 && y.stride() == 1) return simd::dot(x.size(), x.data(), y.data());
+    }
+    V sum = V();
+    for (size_t i = 0; i < x.size(); ++i) sum += x[i] * y[i];
+    return sum;
+}
+
+/**
+ * @brief y := alpha·x + y over two views
+ */
+template<typename T, typename U>
+void axpy(T alpha, const VectorView<U>& x, const VectorView<T>& y) {
+    static_assert(std::is_same_v<T, std::remove_const_t<U>>, "Views must have the same element type");
+    if (x.size() != y.size()) {
+        throw std::invalid_argument("Vector dimensions mismatch for axpy");
+    }
+    if constexpr (simd::has_kernels<T>) {
+        if (x.stride() == 1 && y.stride() == 1) {
+            simd::axpy(x.size(), alpha, x.data(), y.data());
+            return;
+        }
+    }
+    for (size_t i = 0; i < x.size(); ++i) y[i] += alpha * x[i];
+}
+
+/**
+ * @brief C := alpha·A·B + beta·C on views
+ *
+ * EDUCATIONAL NOTE:
+ * The GEMM engine already addresses every operand through two strides, so
+ * transposed operands and submatrices are packed straight from where they
+ * live: gemm(1.0, A.view().transpose(), B.block(0, 0, k, n), 0.0, C.view())
+ * computes Aᵀ·B₀ without forming Aᵀ or copying the block.
+ *
+ * @throws std::invalid_argument on dimension mismatch
+ */
+template<typename T, typename TA, typename TB>
+void gemm(T alpha, const MatrixView<TA>& A, const MatrixView<TB>& B, T beta, const MatrixView<T>& C) {
+    static_assert(std::is_same_v<T, std::remove_const_t<TA>> && std::is_same_v<T, std::remove_const_t<TB>>,
+                  "Views must have the same element type");
+    if (A.get_cols() != B.get_rows() || A.get_rows() != C.get_rows() || B.get_cols() != C.get_cols()) {
+        throw std::invalid_argument("Matrix dimensions mismatch for multiplication");
+    }
+    const size_t m = A.get_rows(), n = B.get_cols(), k = A.get_cols();
+    if constexpr (gemm_supported<T>) {
+        gemm(m, n, k, alpha, A.data(), A.row_stride(), A.col_stride(),
+             B.data(), B.row_stride(), B.col_stride(), beta, C.data(), C.row_stride(), C.col_stride());
+    } else {
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                T sum = T();
+                for (size_t p = 0; p < k; ++p) sum += A(i, p) * B(p, j);
+                C(i, j) = beta == T(0) ? alpha * sum : alpha * sum + beta * C(i, j);
+            }
+        }
+    }
+}
+
+/**
+ * @brief y := alpha·A·x + beta·y on views
+ *
+ * EDUCATIONAL NOTE:
+ * With contiguous x and y, a view with unit column stride runs the
+ * row-wise dot kernel, and one with unit row stride (a transposed view)
+ * runs the axpy-based Aᵀ·x kernel on the underlying storage, so both read
+ * memory contiguously. Other strides use a plain loop.
+ *
+ * @throws std::invalid_argument on dimension mismatch
+ */
+template<typename T, typename TA, typename TX>
+void gemv(T alpha, const MatrixView<TA>& A, const VectorView<TX>& x, T beta, const VectorView<T>& y) {
+    static_assert(std::is_same_v<T, std::remove_const_t<TA>> && std::is_same_v<T, std::remove_const_t<TX>>,
+                  "Views must have the same element type");
+    if (A.get_cols() != x.size() || A.get_rows() != y.size()) {
+        throw std::invalid_argument("Matrix and vector dimensions mismatch for multiplication");
+    }
+    const size_t m = A.get_rows(), n = A.get_cols();
+    if constexpr (simd::has_kernels<T>) {
+        if (x.stride() == 1 && y.stride() == 1) {
+            if (A.col_stride() == 1) {
+                gemv(m, n, alpha, A.data(), A.row_stride(), x.data(), beta, y.data());
+                return;
+            }
+            if (A.row_stride() == 1) {
+                gemv_transposed(n, m, alpha, A.data(), A.col_stride(), x.data(), beta, y.data());
+                return;
+            }
+        }
+    }
+    for (size_t i = 0; i < m; ++i) {
+        T sum = T();
+        for (size_t j = 0; j < n; ++j) sum += A(i, j) * x[j];
+        y[i] = beta == T(0) ? alpha * sum : alpha * sum + beta * y[i];
+    }
+}
+
+} // namespace linalg
+
+#endif // VIEW_HPP
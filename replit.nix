@@ -3,6 +3,7 @@
     pkgs.pkg-config
     pkgs.cmake
     pkgs.gtest
+    pkgs.gbenchmark
     pkgs.gcc
   ];
 }
@@ -3,7 +3,43 @@
 #include "../include/vector.hpp"
 #include "../include/linalg.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cmath>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <vector>
+
+/**
+ * ALLOCATION COUNTING:
+ * The global operator new is replaced so tests can check that hot paths
+ * (workspace solves, Krylov iterations) do not touch the heap. The count is
+ * per thread: it covers the calling thread, which also queues the thread
+ * pool's tasks, but not the one-time buffers of pool workers.
+ */
+namespace {
+thread_local size_t heap_allocations = 0;
+
+void* counted_allocation(std::size_t size, std::size_t alignment) {
+    ++heap_allocations;
+    size = size == 0 ? alignment : (size + alignment - 1) / alignment * alignment;
+    if (void* p = std::aligned_alloc(alignment, size)) return p;
+    throw std::bad_alloc();
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+    return counted_allocation(size, alignof(std::max_align_t));
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
 
 /**
  * EDUCATIONAL TEST SUITE
@@ -74,6 +110,280 @@ TEST_F(MatrixTest, MatrixMultiplication) {
     EXPECT_EQ(C.at(1, 1), 50) << "Fourth element of product incorrect";
 }
 
+/**
+ * TEST CASE: Blocked Matrix Multiplication
+ * 
+ * Verifies:
+ * 1. Products above the naive threshold use the blocked GEMM engine
+ * 2. Ragged sizes (not multiples of the register tile) are handled
+ * 3. Results match a straightforward reference triple loop
+ */
+TEST_F(MatrixTest, BlockedMatrixMultiplication) {
+    const size_t m = 67, k = 129, n = 53;
+    Matrix<double> A(m, k);
+    Matrix<double> B(k, n);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < k; ++j)
+            A.at(i, j) = static_cast<double>((i * 7 + j * 3) % 11) - 5.0;
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < n; ++j)
+            B.at(i, j) = static_cast<double>((i * 5 + j * 2) % 13) * 0.5;
+
+    Matrix<double> C = A * B;
+    ASSERT_EQ(C.get_rows(), m);
+    ASSERT_EQ(C.get_cols(), n);
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            double expected = 0.0;
+            for (size_t p = 0; p < k; ++p) {
+                expected += A.at(i, p) * B.at(p, j);
+            }
+            EXPECT_NEAR(C.at(i, j), expected, 1e-9) << "Mismatch at (" << i << ", " << j << ")";
+        }
+    }
+}
+
+/**
+ * TEST CASE: SIMD Kernels
+ * 
+ * Verifies:
+ * 1. Every ISA level the CPU supports agrees with the portable kernels
+ * 2. Tails (lengths not a multiple of the vector width) are handled
+ * 3. The GEMM micro-kernel of each level produces the same tile
+ */
+template<typename T>
+void check_simd_level(linalg::simd::isa level, T tol) {
+    using namespace linalg::simd;
+    const kernel_table<T> ref = kernels_for<T>(isa::scalar);
+    const kernel_table<T> k = kernels_for<T>(level);
+    SCOPED_TRACE(isa_name(level));
+
+    for (size_t n : {0u, 1u, 7u, 16u, 37u, 130u}) {
+        std::vector<T> x(n), y(n), y_ref;
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = static_cast<T>(i % 5) - T(2);
+            y[i] = static_cast<T>(i % 3) + T(0.5);
+        }
+        EXPECT_NEAR(k.dot(n, x.data(), y.data()), ref.dot(n, x.data(), y.data()), tol);
+
+        y_ref = y;
+        k.axpy(n, T(1.5), x.data(), y.data());
+        ref.axpy(n, T(1.5), x.data(), y_ref.data());
+        k.axpby(n, T(-0.5), x.data(), T(2), y.data());
+        ref.axpby(n, T(-0.5), x.data(), T(2), y_ref.data());
+        k.scal(n, T(0.25), y.data());
+        ref.scal(n, T(0.25), y_ref.data());
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(y[i], y_ref[i], tol) << "n = " << n << ", i = " << i;
+        }
+    }
+
+    const size_t mr = k.gemm.mr, nr = k.gemm.nr, kc = 19;
+    std::vector<T> a(kc * mr), b(kc * nr), c(mr * nr, T(1)), c_ref(mr * nr, T(1));
+    for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<T>(i % 7) - T(3);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<T>(i % 4) * T(0.5);
+    k.gemm.fn(kc, T(2), a.data(), b.data(), c.data(), nr, true);
+    for (size_t i = 0; i < mr; ++i) {
+        for (size_t j = 0; j < nr; ++j) {
+            T sum = T();
+            for (size_t p = 0; p < kc; ++p) sum += a[p * mr + i] * b[p * nr + j];
+            c_ref[i * nr + j] += T(2) * sum;
+        }
+    }
+    for (size_t i = 0; i < c.size(); ++i) {
+        EXPECT_NEAR(c[i], c_ref[i], tol) << "tile element " << i;
+    }
+}
+
+TEST_F(MatrixTest, SimdKernels) {
+    using linalg::simd::isa;
+    for (isa level : {isa::scalar, isa::avx2, isa::avx512, isa::neon}) {
+        if (linalg::simd::isa_supported(level)) {
+            check_simd_level<double>(level, 1e-12);
+            check_simd_level<float>(level, 1e-3f);
+        }
+    }
+
+    Matrix<float> A(40, 45), B(45, 50);
+    for (size_t i = 0; i < 40; ++i)
+        for (size_t j = 0; j < 45; ++j)
+            A.at(i, j) = static_cast<float>((i + 2 * j) % 9) - 4.0f;
+    for (size_t i = 0; i < 45; ++i)
+        for (size_t j = 0; j < 50; ++j)
+            B.at(i, j) = static_cast<float>((3 * i + j) % 7) * 0.25f;
+    Matrix<float> C = A * B;
+    for (size_t i = 0; i < 40; ++i) {
+        for (size_t j = 0; j < 50; ++j) {
+            float expected = 0.0f;
+            for (size_t p = 0; p < 45; ++p) expected += A.at(i, p) * B.at(p, j);
+            EXPECT_NEAR(C.at(i, j), expected, 1e-3f);
+        }
+    }
+}
+
+/**
+ * TEST CASE: Thread Pool
+ * 
+ * Verifies:
+ * 1. parallel_for visits every index exactly once
+ * 2. Nested parallel_for calls complete (callers help, no deadlock)
+ * 3. Exceptions thrown by tasks reach the caller
+ */
+TEST_F(MatrixTest, ThreadPool) {
+    linalg::ThreadPool pool(4);
+    EXPECT_EQ(pool.num_threads(), 4u);
+
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallel_for(hits.size(), [&](size_t i) { hits[i].fetch_add(1); });
+    for (size_t i = 0; i < hits.size(); ++i) {
+        EXPECT_EQ(hits[i].load(), 1) << "Index " << i;
+    }
+
+    std::atomic<size_t> total{0};
+    pool.parallel_for(8, [&](size_t) {
+        pool.parallel_for(16, [&](size_t j) { total.fetch_add(j); });
+    });
+    EXPECT_EQ(total.load(), 8u * 120u) << "Nested parallel_for lost work";
+
+    EXPECT_THROW(pool.parallel_for(10, [](size_t i) {
+        if (i == 7) throw std::runtime_error("task failed");
+    }), std::runtime_error);
+}
+
+/**
+ * TEST CASE: Parallel Matrix Multiplication
+ * 
+ * Verifies that a product large enough to be tiled across the default
+ * pool matches the single-threaded result exactly.
+ */
+TEST_F(MatrixTest, ParallelMatrixMultiplication) {
+    const size_t m = 150, k = 160, n = 170;
+    Matrix<double> A(m, k);
+    Matrix<double> B(k, n);
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < k; ++j)
+            A.at(i, j) = static_cast<double>((i * 13 + j * 7) % 17) - 8.0;
+    for (size_t i = 0; i < k; ++i)
+        for (size_t j = 0; j < n; ++j)
+            B.at(i, j) = static_cast<double>((i * 3 + j * 11) % 19) * 0.25;
+
+    linalg::set_num_threads(1);
+    Matrix<double> serial = A * B;
+    linalg::set_num_threads(4);
+    Matrix<double> parallel = A * B;
+    linalg::set_num_threads(linalg::default_num_threads());
+
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            EXPECT_EQ(parallel.at(i, j), serial.at(i, j)) << "Mismatch at (" << i << ", " << j << ")";
+        }
+    }
+}
+
+/**
+ * TEST CASE: Unchecked Access and Storage Views
+ * 
+ * Verifies:
+ * 1. operator() and operator[] address the same elements as at()
+ * 2. row() spans and the full-buffer span() alias the storage
+ * 3. Strides describe the row-major layout
+ * 4. row() keeps bounds checking
+ */
+TEST_F(MatrixTest, StorageViews) {
+    Matrix<double> m(3, 4);
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            m(i, j) = static_cast<double>(10 * i + j);
+
+    EXPECT_EQ(m.row_stride(), 4u);
+    EXPECT_EQ(m.col_stride(), 1u);
+    EXPECT_DOUBLE_EQ(m.at(2, 3), 23.0);
+    EXPECT_EQ(&m(1, 2), m.data() + 1 * m.row_stride() + 2 * m.col_stride());
+
+    linalg::Span<double> row = m.row(1);
+    ASSERT_EQ(row.size(), 4u);
+    EXPECT_EQ(row.data(), &m(1, 0));
+    for (double& value : row) value *= 2;
+    EXPECT_DOUBLE_EQ(m.at(1, 3), 26.0);
+    EXPECT_THROW(m.row(3), std::out_of_range);
+
+    const Matrix<double>& cm = m;
+    linalg::Span<const double> all = cm.span();
+    EXPECT_EQ(all.size(), 12u);
+    EXPECT_DOUBLE_EQ(all[11], 23.0);
+    EXPECT_DOUBLE_EQ(all.subspan(4, 4)[0], 20.0);
+
+    Vector<double> v(5);
+    for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<double>(i);
+    EXPECT_DOUBLE_EQ(v.at(4), 4.0);
+    EXPECT_EQ(v.data() + 3, &v.at(3));
+    EXPECT_EQ(v.stride(), 1u);
+    EXPECT_EQ(v.span().size(), 5u);
+}
+
+/**
+ * TEST CASE: Elementwise Expressions
+ * 
+ * Verifies:
+ * 1. C = a*A + b*B - D evaluates correctly in one pass
+ * 2. Self-referencing assignment and compound operators
+ * 3. Large (parallel) evaluation and vector expressions
+ * 4. Shape mismatches are rejected
+ */
+TEST_F(MatrixTest, ElementwiseExpressions) {
+    Matrix<double> A(3, 5), B(3, 5), D(3, 5);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 5; ++j) {
+            A(i, j) = static_cast<double>(i + j);
+            B(i, j) = static_cast<double>(i * j);
+            D(i, j) = 1.0;
+        }
+    }
+
+    Matrix<double> C = 2.0 * A + B * 3 - D;
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 5; ++j)
+            EXPECT_DOUBLE_EQ(C(i, j), 2.0 * (i + j) + 3.0 * (i * j) - 1.0);
+
+    C = C - A / 2;  // operand aliases the destination
+    C += -D;
+    C -= 0.5 * A;
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 5; ++j)
+            EXPECT_DOUBLE_EQ(C(i, j), 2.0 * (i + j) + 3.0 * (i * j) - 2.0 - 1.0 * (i + j));
+
+    C = A + A + A;  // same shape: no reallocation
+    EXPECT_DOUBLE_EQ(C(2, 4), 18.0);
+
+    const size_t n = 1024;  // above expression_parallel_limit
+    Matrix<float> X(n, n), Y(n, n);
+    for (size_t i = 0; i < n * n; ++i) {
+        X.data()[i] = static_cast<float>(i % 97);
+        Y.data()[i] = static_cast<float>(i % 13);
+    }
+    for (size_t threads : {1u, 4u}) {
+        linalg::set_num_threads(threads);
+        Matrix<float> Z = X - 2 * Y;
+        for (size_t i = 0; i < n * n; i += 4099) {
+            ASSERT_FLOAT_EQ(Z.data()[i], static_cast<float>(i % 97) - 2.0f * (i % 13));
+        }
+    }
+    linalg::set_num_threads(linalg::default_num_threads());
+
+    Vector<double> u(4), v(4);
+    for (size_t i = 0; i < 4; ++i) {
+        u[i] = static_cast<double>(i);
+        v[i] = 1.0;
+    }
+    Vector<double> w = u + 2.0 * v;
+    EXPECT_DOUBLE_EQ(w[3], 5.0);
+    w -= u;
+    EXPECT_DOUBLE_EQ(w.dot(v), 8.0);
+
+    EXPECT_THROW(A + Matrix<double>(5, 3), std::invalid_argument);
+    EXPECT_THROW(Vector<double>(A - B), std::invalid_argument);
+}
+
 /**
  * TEST CASE: Vector Operations
  * 
@@ -94,6 +404,67 @@ TEST_F(MatrixTest, VectorOperations) {
     EXPECT_EQ(v.norm(), 3.0) << "Vector norm calculation incorrect";
 }
 
+/**
+ * TEST CASE: Vector Storage and Kernels
+ * 
+ * Verifies:
+ * 1. Short vectors are stored inline; long ones in a 64-byte aligned buffer
+ * 2. Copy and move (construction and assignment) across both storage kinds
+ * 3. axpy and dot on long vectors
+ * 4. norm() survives overflow and underflow of the sum of squares
+ */
+TEST_F(MatrixTest, VectorStorage) {
+    Vector<double> small(3);
+    const char* object = reinterpret_cast<const char*>(&small);
+    EXPECT_TRUE(reinterpret_cast<const char*>(small.data()) >= object &&
+                reinterpret_cast<const char*>(small.data()) < object + sizeof(small))
+        << "3 doubles should use the inline buffer";
+
+    Vector<double> big(1001);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big.data()) % 64, 0u);
+    for (size_t i = 0; i < big.size(); ++i) big[i] = static_cast<double>(i);
+    small[0] = 1.0; small[1] = 2.0; small[2] = 3.0;
+
+    Vector<double> big_copy(big), small_copy(small);
+    EXPECT_DOUBLE_EQ(big_copy[1000], 1000.0);
+    EXPECT_DOUBLE_EQ(small_copy[2], 3.0);
+
+    const double* buffer = big_copy.data();
+    Vector<double> moved(std::move(big_copy));
+    EXPECT_EQ(moved.data(), buffer) << "moving a heap vector must not copy";
+    Vector<double> small_moved(std::move(small_copy));
+    EXPECT_DOUBLE_EQ(small_moved[1], 2.0);
+
+    small_moved = big;           // inline -> heap
+    EXPECT_EQ(small_moved.size(), 1001u);
+    moved = small;               // heap -> inline
+    EXPECT_EQ(moved.size(), 3u);
+    EXPECT_DOUBLE_EQ(moved[2], 3.0);
+    moved = std::move(small_moved);
+    EXPECT_DOUBLE_EQ(moved[500], 500.0);
+
+    Vector<double> y(1001);
+    for (size_t i = 0; i < y.size(); ++i) y[i] = 1.0;
+    y.axpy(-2.0, big);
+    EXPECT_DOUBLE_EQ(y[10], -19.0);
+    EXPECT_DOUBLE_EQ(y.dot(moved), 1001.0 * 500.0 - 2.0 * (1000.0 * 1001.0 * 2001.0 / 6.0));
+    EXPECT_THROW(y.axpy(1.0, small), std::invalid_argument);
+    EXPECT_THROW(small.at(3), std::out_of_range);
+    EXPECT_THROW(Vector<double>(0), std::invalid_argument);
+
+    Vector<double> huge(2), tiny(2), zero(5), inf(2);
+    huge[0] = 3e200; huge[1] = 4e200;
+    tiny[0] = 3e-200; tiny[1] = 4e-200;
+    inf[0] = 1.0; inf[1] = std::numeric_limits<double>::infinity();
+    EXPECT_DOUBLE_EQ(huge.norm(), 5e200);
+    EXPECT_DOUBLE_EQ(tiny.norm(), 5e-200);
+    EXPECT_EQ(zero.norm(), 0.0);
+    EXPECT_TRUE(std::isinf(inf.norm()));
+    Vector<float> f(2);
+    f[0] = 3e30f; f[1] = 4e30f;
+    EXPECT_FLOAT_EQ(f.norm(), 5e30f);
+}
+
 /**
  * TEST CASE: Linear Transformations
  * 
@@ -114,19 +485,1352 @@ TEST_F(MatrixTest, LinearTransformations) {
     v.at(1) = 0;
     v.at(2) = 0;
 
-    // Convert vector to matrix for multiplication
-    Matrix<double> v_matrix(3, 1);
+    // Apply rotation (matrix-vector product, no conversion to Matrix)
+    Vector<double> result = rot * v;
+    
+    // Verify rotation results with small error tolerance
+    EXPECT_NEAR(result.at(0), 0.0, 1e-10) << "X coordinate after rotation";
+    EXPECT_NEAR(result.at(1), 1.0, 1e-10) << "Y coordinate after rotation";
+    EXPECT_NEAR(result.at(2), 0.0, 1e-10) << "Z coordinate after rotation";
+}
+
+/**
+ * TEST CASE: Matrix-Vector Products (GEMV)
+ * 
+ * Verifies:
+ * 1. A·x and Aᵀ·x against direct sums, for a non-square A
+ * 2. alpha/beta scaling, including beta = 0 ignoring NaN in y
+ * 3. Parallel row and column splitting agree with the serial path
+ * 4. Dimension mismatches and aliasing are rejected
+ */
+TEST_F(MatrixTest, MatrixVectorProduct) {
+    for (size_t threads : {1u, 4u}) {
+        linalg::set_num_threads(threads);
+        for (size_t m : {size_t(7), size_t(300)}) {
+            const size_t n = m + 45;  // 300 x 345 takes the parallel path
+            Matrix<double> A(m, n);
+            Vector<double> x(n), xt(m);
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < n; ++j) A(i, j) = std::sin(0.01 * static_cast<double>(i * n + j));
+                xt[i] = 1.0 / (1.0 + i);
+            }
+            for (size_t j = 0; j < n; ++j) x[j] = std::cos(static_cast<double>(j));
+
+            const Vector<double> y = A * x;
+            Vector<double> y2(m), z(n);
+            for (size_t i = 0; i < m; ++i) y2[i] = std::nan("");
+            for (size_t j = 0; j < n; ++j) z[j] = 1.0;
+            linalg::gemv(2.0, A, x, 0.0, y2);
+            linalg::gemv_transposed(1.0, A, xt, -3.0, z);
+
+            for (size_t i = 0; i < m; ++i) {
+                double sum = 0.0;
+                for (size_t j = 0; j < n; ++j) sum += A(i, j) * x[j];
+                EXPECT_NEAR(y[i], sum, 1e-10);
+                EXPECT_NEAR(y2[i], 2.0 * sum, 1e-10);
+            }
+            for (size_t j = 0; j < n; ++j) {
+                double sum = 0.0;
+                for (size_t i = 0; i < m; ++i) sum += A(i, j) * xt[i];
+                EXPECT_NEAR(z[j], sum - 3.0, 1e-10);
+            }
+        }
+    }
+    linalg::set_num_threads(linalg::default_num_threads());
+
+    Matrix<double> A(2, 3);
+    Vector<double> v3(3), v2(2);
+    EXPECT_THROW(A * v2, std::invalid_argument);
+    EXPECT_THROW(linalg::gemv(1.0, A, v3, 0.0, v3), std::invalid_argument);
+    Matrix<double> S(3, 3);
+    EXPECT_THROW(linalg::gemv(1.0, S, v3, 0.0, v3), std::invalid_argument);
+}
+
+/**
+ * TEST CASE: Fixed-Size Matrices
+ * 
+ * Verifies:
+ * 1. Construction and products are usable in constant expressions
+ * 2. Fixed rotations agree with the dynamic rotation matrices
+ * 3. Conversions to and from Matrix/Vector, with shape checks
+ * 4. 4x4 homogeneous transforms apply rotation plus translation
+ */
+TEST_F(MatrixTest, FixedSizeMatrices) {
+    constexpr linalg::FixedMatrix<int, 2, 3> a{1, 2, 3,
+                                               4, 5, 6};
+    constexpr linalg::FixedVector<int, 3> x{1, 0, -1};
+    constexpr linalg::FixedVector<int, 2> y = a * x;
+    static_assert(y[0] == -2 && y[1] == -2, "constexpr product");
+    static_assert(linalg::FixedMatrix<int, 3, 3>::identity() * x == x, "identity");
+    static_assert((a.transpose() * a)(2, 2) == 45, "AᵀA");
+    static_assert(linalg::dot(x, x) == 2, "dot");
+
+    const double angle = 0.3;
+    const linalg::Matrix3d rz = linalg::fixed_rotation_z(angle);
+    const Matrix<double> dynamic = linalg::rotation_z(angle);
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            EXPECT_DOUBLE_EQ(rz(i, j), dynamic.at(i, j));
+    EXPECT_EQ(linalg::Matrix3d(dynamic), rz);
+
+    const linalg::Vector3d p{1.0, 2.0, 3.0};
+    const linalg::Vector3d q = linalg::fixed_rotation_x(angle) * p;
+    EXPECT_NEAR(linalg::norm(q), linalg::norm(p), 1e-12);
+    EXPECT_DOUBLE_EQ(q[0], 1.0);
+
+    const Vector<double> v = q.to_vector();
+    EXPECT_DOUBLE_EQ(v.at(2), q[2]);
+    EXPECT_EQ(linalg::Vector3d(v), q);
+    EXPECT_THROW(linalg::Matrix4d{dynamic}, std::invalid_argument);
+    EXPECT_THROW(linalg::Vector4d{v}, std::invalid_argument);
+
+    const linalg::Matrix4d h = linalg::homogeneous(linalg::fixed_rotation_z(M_PI / 2.0),
+                                                   linalg::Vector3d{0.0, 0.0, 5.0});
+    const linalg::Vector4d moved = h * linalg::Vector4d{1.0, 0.0, 0.0, 1.0};
+    EXPECT_NEAR(moved[0], 0.0, 1e-12);
+    EXPECT_NEAR(moved[1], 1.0, 1e-12);
+    EXPECT_NEAR(moved[2], 5.0, 1e-12);
+    EXPECT_DOUBLE_EQ(moved[3], 1.0);
+    EXPECT_EQ(linalg::cross(linalg::Vector3d{1, 0, 0}, linalg::Vector3d{0, 1, 0}),
+              (linalg::Vector3d{0, 0, 1}));
+}
+
+/**
+ * TEST CASE: Quaternions and Closed-Form Rotations
+ * 
+ * Verifies:
+ * 1. sincos matches std::sin / std::cos
+ * 2. Closed-form roll-pitch-yaw equals Rz·Ry·Rx, as a matrix and a quaternion
+ * 3. Round trips matrix -> quaternion -> matrix and axis-angle <-> quaternion
+ * 4. Quaternion products compose rotations; rotate() matches the matrix
+ * 5. slerp halfway between two rotations about one axis
+ */
+TEST_F(MatrixTest, QuaternionRotations) {
+    for (double angle : {-2.5, 0.0, 0.7, 3.0}) {
+        const linalg::SinCos<double> sc = linalg::sincos(angle);
+        EXPECT_DOUBLE_EQ(sc.sin, std::sin(angle));
+        EXPECT_DOUBLE_EQ(sc.cos, std::cos(angle));
+    }
+    EXPECT_FLOAT_EQ(linalg::sincos(0.5f).cos, std::cos(0.5f));
+
+    auto expect_matrix_near = [](const linalg::Matrix3d& a, const linalg::Matrix3d& b) {
+        for (size_t i = 0; i < 3; ++i)
+            for (size_t j = 0; j < 3; ++j)
+                EXPECT_NEAR(a(i, j), b(i, j), 1e-12) << "(" << i << ", " << j << ")";
+    };
+
+    const double roll = 0.3, pitch = -1.2, yaw = 2.4;
+    const linalg::Matrix3d composed = linalg::fixed_rotation_z(yaw) * linalg::fixed_rotation_y(pitch)
+                                      * linalg::fixed_rotation_x(roll);
+    expect_matrix_near(linalg::fixed_rotation_rpy(roll, pitch, yaw), composed);
+
+    const linalg::Quaterniond q = linalg::Quaterniond::from_rpy(roll, pitch, yaw);
+    EXPECT_NEAR(q.norm(), 1.0, 1e-12);
+    expect_matrix_near(q.to_matrix(), composed);
+
+    // Shepperd's method, including a rotation by π (w = 0)
+    for (const linalg::Matrix3d& m : {composed, linalg::fixed_rotation_y(M_PI),
+                                      linalg::fixed_rotation_x(3.1), linalg::Matrix3d::identity()}) {
+        expect_matrix_near(linalg::Quaterniond::from_matrix(m).to_matrix(), m);
+    }
+
+    const linalg::Quaterniond qx = linalg::Quaterniond::from_axis_angle(linalg::Vector3d{1, 0, 0}, roll);
+    const linalg::Quaterniond qy = linalg::Quaterniond::from_axis_angle(linalg::Vector3d{0, 1, 0}, pitch);
+    const linalg::Quaterniond qz = linalg::Quaterniond::from_axis_angle(linalg::Vector3d{0, 0, 1}, yaw);
+    expect_matrix_near((qz * qy * qx).to_matrix(), composed);
+    expect_matrix_near((q * q.inverse()).to_matrix(), linalg::Matrix3d::identity());
+
+    const linalg::Vector3d p{0.5, -1.0, 2.0};
+    const linalg::Vector3d by_matrix = composed * p;
+    const linalg::Vector3d by_quaternion = q.rotate(p);
+    for (size_t i = 0; i < 3; ++i) EXPECT_NEAR(by_quaternion[i], by_matrix[i], 1e-12);
+
+    const linalg::AxisAngle<double> aa(linalg::Vector3d{1, 2, 2}, 0.9);
+    EXPECT_NEAR(linalg::norm(aa.axis), 1.0, 1e-15);
+    expect_matrix_near(aa.to_matrix(), aa.to_quaternion().to_matrix());
+    const linalg::AxisAngle<double> back = linalg::AxisAngle<double>::from_quaternion(aa.to_quaternion());
+    EXPECT_NEAR(back.angle, 0.9, 1e-12);
+    EXPECT_NEAR(back.axis[1], 2.0 / 3.0, 1e-12);
+    EXPECT_THROW(linalg::AxisAngle<double>(linalg::Vector3d{}, 1.0), std::invalid_argument);
+
+    const linalg::Quaterniond half = linalg::Quaterniond::slerp(linalg::Quaterniond::identity(), qz, 0.5);
+    expect_matrix_near(half.to_matrix(), linalg::fixed_rotation_z(yaw / 2));
+}
+
+/**
+ * TEST CASE: Batched Point Transforms
+ * 
+ * Verifies:
+ * 1. SoA and AoS (packed, xyzw and wider strides) give the same results as
+ *    the per-point FixedMatrix product
+ * 2. 4x4 affine and projective (divide by w) transforms
+ * 3. Large batches (SIMD blocks plus parallel chunks) and odd tails
+ * 4. Invalid strides and mismatched spans are rejected
+ */
+TEST_F(MatrixTest, BatchedPointTransforms) {
+    const linalg::Matrix3d r = linalg::fixed_rotation_x(0.4) * linalg::fixed_rotation_z(1.1);
+    linalg::Matrix4d projective = linalg::homogeneous(r, linalg::Vector3d{1.0, -2.0, 0.5});
+    projective(3, 2) = 0.25;
+    projective(3, 3) = 2.0;
+
+    auto point = [](size_t i) {
+        return linalg::Vector3d{std::sin(0.1 * i), std::cos(0.3 * i), 0.01 * static_cast<double>(i % 100)};
+    };
+    auto expected = [&](const linalg::Matrix4d& h, const linalg::Vector3d& p) {
+        const linalg::Vector4d q = h * linalg::Vector4d{p[0], p[1], p[2], 1.0};
+        return linalg::Vector3d{q[0] / q[3], q[1] / q[3], q[2] / q[3]};
+    };
+
+    for (size_t n : {size_t(37), size_t(100003)}) {  // 100003: parallel path, odd tail
+        for (size_t threads : {1u, 4u}) {
+            linalg::set_num_threads(threads);
+            std::vector<double> xs(n), ys(n), zs(n), aos(3 * n), xyzw(4 * n);
+            for (size_t i = 0; i < n; ++i) {
+                const linalg::Vector3d p = point(i);
+                xs[i] = aos[3 * i] = xyzw[4 * i] = p[0];
+                ys[i] = aos[3 * i + 1] = xyzw[4 * i + 1] = p[1];
+                zs[i] = aos[3 * i + 2] = xyzw[4 * i + 2] = p[2];
+                xyzw[4 * i + 3] = -1.0;
+            }
+            linalg::transform_points(r, xs.data(), ys.data(), zs.data(), n);
+            linalg::transform_points(r, aos.data(), n);
+            linalg::transform_points(projective, xyzw.data(), n, 4);
+
+            for (size_t i = 0; i < n; i += (n > 1000 ? 997 : 1)) {
+                const linalg::Vector3d q = r * point(i);
+                const linalg::Vector3d h = expected(projective, point(i));
+                for (size_t c = 0; c < 3; ++c) {
+                    EXPECT_NEAR((c == 0 ? xs : c == 1 ? ys : zs)[i], q[c], 1e-12);
+                    EXPECT_NEAR(aos[3 * i + c], q[c], 1e-12);
+                    EXPECT_NEAR(xyzw[4 * i + c], h[c], 1e-12);
+                }
+                EXPECT_EQ(xyzw[4 * i + 3], -1.0) << "padding must be untouched";
+            }
+        }
+    }
+    linalg::set_num_threads(linalg::default_num_threads());
+
+    // Affine 4x4 on float SoA through spans, and a 5-element record stride
+    std::vector<float> fx{1, 0, 0}, fy{0, 1, 0}, fz{0, 0, 1};
+    const linalg::Matrix4f shift = linalg::homogeneous(linalg::Matrix3f::identity(),
+                                                       linalg::Vector3f{1.0f, 2.0f, 3.0f});
+    linalg::transform_points(shift, linalg::Span<float>(fx.data(), 3),
+                             linalg::Span<float>(fy.data(), 3), linalg::Span<float>(fz.data(), 3));
+    EXPECT_FLOAT_EQ(fx[0], 2.0f);
+    EXPECT_FLOAT_EQ(fy[1], 3.0f);
+    EXPECT_FLOAT_EQ(fz[2], 4.0f);
+
+    std::vector<double> records{1, 0, 0, 7, 7, 0, 1, 0, 7, 7};
+    linalg::transform_points(linalg::fixed_rotation_z(M_PI / 2.0), records.data(), 2, 5);
+    EXPECT_NEAR(records[1], 1.0, 1e-12);
+    EXPECT_NEAR(records[5], -1.0, 1e-12);
+    EXPECT_EQ(records[3], 7.0);
+
+    EXPECT_THROW(linalg::transform_points(r, records.data(), 2, 2), std::invalid_argument);
+    EXPECT_THROW(linalg::transform_points(r, linalg::Span<double>(records.data(), 3),
+                                          linalg::Span<double>(records.data(), 3),
+                                          linalg::Span<double>(records.data(), 2)),
+                 std::invalid_argument);
+}
+
+/**
+ * TEST CASE: LU Factorization
+ * 
+ * Verifies:
+ * 1. One factorization solves several right-hand sides
+ * 2. Partial pivoting handles a zero leading entry
+ * 3. Determinant and singularity detection
+ * 
+ * Mathematical Background:
+ * [0 2 1]       [3]             [1]
+ * [1 1 1] · x = [3]   =>   x = [1]
+ * [2 1 3]       [6]             [1]
+ */
+TEST_F(MatrixTest, LUFactorization) {
+    Matrix<double> A(3, 3);
+    A.at(0, 0) = 0; A.at(0, 1) = 2; A.at(0, 2) = 1;
+    A.at(1, 0) = 1; A.at(1, 1) = 1; A.at(1, 2) = 1;
+    A.at(2, 0) = 2; A.at(2, 1) = 1; A.at(2, 2) = 3;
+
+    linalg::LU<double> lu(A);
+    EXPECT_NEAR(lu.determinant(), -3.0, 1e-12) << "det(A) = -3";
+
+    Vector<double> b(3);
+    b.at(0) = 3; b.at(1) = 3; b.at(2) = 6;
+    Vector<double> x = lu.solve(b);
     for (size_t i = 0; i < 3; ++i) {
-        v_matrix.at(i, 0) = v.at(i);
+        EXPECT_NEAR(x.at(i), 1.0, 1e-12) << "Component " << i;
     }
 
-    // Apply rotation
-    Matrix<double> result = rot * v_matrix;
-    
-    // Verify rotation results with small error tolerance
-    EXPECT_NEAR(result.at(0, 0), 0.0, 1e-10) << "X coordinate after rotation";
-    EXPECT_NEAR(result.at(1, 0), 1.0, 1e-10) << "Y coordinate after rotation";
-    EXPECT_NEAR(result.at(2, 0), 0.0, 1e-10) << "Z coordinate after rotation";
+    // Reuse the same factors for a second right-hand side: x = (1, 2, 3)
+    b.at(0) = 7; b.at(1) = 6; b.at(2) = 13;
+    Vector<double> y = lu.solve(b);
+    EXPECT_NEAR(y.at(0), 1.0, 1e-12);
+    EXPECT_NEAR(y.at(1), 2.0, 1e-12);
+    EXPECT_NEAR(y.at(2), 3.0, 1e-12);
+
+    Matrix<double> singular(2, 2);
+    singular.at(0, 0) = 1; singular.at(0, 1) = 2;
+    singular.at(1, 0) = 2; singular.at(1, 1) = 4;
+    EXPECT_THROW(linalg::LU<double>{singular}, std::runtime_error);
+    EXPECT_THROW(linalg::LU<double>{Matrix<double>(2, 3)}, std::invalid_argument);
+}
+
+/**
+ * TEST CASE: Solving a Larger System
+ * 
+ * Builds b = A·x_true for a diagonally dominant 80x80 matrix and checks
+ * that solve_linear_system recovers x_true.
+ */
+TEST_F(MatrixTest, SolveLinearSystem) {
+    const size_t n = 80;
+    Matrix<double> A(n, n);
+    Vector<double> x_true(n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            A.at(i, j) = std::sin(static_cast<double>(i * n + j));
+        }
+        A.at(i, i) += static_cast<double>(n);
+        x_true.at(i) = static_cast<double>(i % 7) - 3.0;
+    }
+    Vector<double> b(n);
+    for (size_t i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (size_t j = 0; j < n; ++j) sum += A.at(i, j) * x_true.at(j);
+        b.at(i) = sum;
+    }
+
+    Vector<double> x = linalg::solve_linear_system(A, b);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(x.at(i), x_true.at(i), 1e-10) << "Component " << i;
+    }
+}
+
+/**
+ * TEST CASE: Blocked LU Factorization
+ * 
+ * Verifies:
+ * 1. Matrices larger than the panel width take the blocked path
+ *    (panel + TRSM + trailing GEMM update)
+ * 2. Single- and multi-threaded factorizations give the same answer
+ */
+TEST_F(MatrixTest, BlockedLUFactorization) {
+    const size_t n = 300;
+    Matrix<double> A(n, n);
+    Vector<double> x_true(n);
+    unsigned state = 12345u;  // small LCG: reproducible, well-conditioned entries
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            state = state * 1664525u + 1013904223u;
+            A.at(i, j) = static_cast<double>(state >> 8) / 16777216.0 - 0.5;
+        }
+        x_true.at(i) = std::cos(static_cast<double>(i));
+    }
+    Vector<double> b(n);
+    for (size_t i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (size_t j = 0; j < n; ++j) sum += A.at(i, j) * x_true.at(j);
+        b.at(i) = sum;
+    }
+
+    for (size_t threads : {1u, 4u}) {
+        linalg::set_num_threads(threads);
+        Vector<double> x = linalg::LU<double>(A).solve(b);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(x.at(i), x_true.at(i), 1e-8) << "threads = " << threads << ", i = " << i;
+        }
+    }
+    linalg::set_num_threads(linalg::default_num_threads());
+}
+
+/**
+ * TEST CASE: Multiple Right-Hand Sides
+ * 
+ * Verifies:
+ * 1. solve_linear_system(A, B) solves every column of B
+ * 2. Results match the single-vector solver column by column
+ * 3. Blocked TRSM path (n > trsm_block_size) with many columns
+ */
+TEST_F(MatrixTest, SolveMultipleRightHandSides) {
+    const size_t n = 150, k = 200;
+    Matrix<double> A(n, n), X_true(n, k);
+    unsigned state = 777u;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            state = state * 1664525u + 1013904223u;
+            A.at(i, j) = static_cast<double>(state >> 8) / 16777216.0 - 0.5;
+        }
+        for (size_t j = 0; j < k; ++j) {
+            X_true.at(i, j) = std::sin(static_cast<double>(i + 3 * j));
+        }
+    }
+    const Matrix<double> B = A * X_true;
+
+    for (size_t threads : {1u, 4u}) {
+        linalg::set_num_threads(threads);
+        Matrix<double> X = linalg::solve_linear_system(A, B);
+        ASSERT_EQ(X.get_rows(), n);
+        ASSERT_EQ(X.get_cols(), k);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < k; ++j) {
+                EXPECT_NEAR(X.at(i, j), X_true.at(i, j), 1e-8) << "threads = " << threads;
+            }
+        }
+    }
+    linalg::set_num_threads(linalg::default_num_threads());
+
+    Vector<double> b(n);
+    for (size_t i = 0; i < n; ++i) b.at(i) = B.at(i, 7);
+    Vector<double> x = linalg::solve_linear_system(A, b);
+    Matrix<double> X = linalg::LU<double>(A).solve(B);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(X.at(i, 7), x.at(i), 1e-10);
+    }
+
+    EXPECT_THROW(linalg::solve_linear_system(A, Matrix<double>(n + 1, 2)), std::invalid_argument);
+}
+
+/**
+ * TEST CASE: In-Place and Workspace Solves
+ * 
+ * Verifies:
+ * 1. solve_in_place overwrites b with x and A with its LU factors
+ * 2. solve_with_workspace leaves A untouched
+ * 3. Workspace buffers are reused (no reallocation) across calls
+ * 4. Above lu_block_size (blocked LU, parallel trailing updates) a warmed-up
+ *    workspace solve makes no heap allocation on the calling thread
+ */
+TEST_F(MatrixTest, SolveInPlace) {
+    const size_t n = 40;
+    Matrix<double> A(n, n);
+    Vector<double> x_true(n), b(n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            A.at(i, j) = std::cos(static_cast<double>(3 * i + j));
+        }
+        A.at(i, i) += static_cast<double>(n);
+        x_true.at(i) = static_cast<double>(i) / n;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (size_t j = 0; j < n; ++j) sum += A.at(i, j) * x_true.at(j);
+        b.at(i) = sum;
+    }
+
+    linalg::LUWorkspace<double> ws;
+    ws.reserve(n);
+    const double* factors = ws.factors.data();
+    const size_t* pivots = ws.pivots.data();
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        Vector<double> x(b);
+        linalg::solve_with_workspace(A, x, ws);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(x.at(i), x_true.at(i), 1e-12);
+        }
+    }
+    EXPECT_EQ(ws.factors.data(), factors);
+    EXPECT_EQ(ws.pivots.data(), pivots);
+
+    Matrix<double> A_copy(A);
+    Vector<double> x(b);
+    linalg::solve_in_place(A_copy, x);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(x.at(i), x_true.at(i), 1e-12);
+        EXPECT_DOUBLE_EQ(A_copy.at(i, i), ws.factors[i * n + i]);
+    }
+
+    Matrix<double> singular(2, 2);
+    Vector<double> rhs(2);
+    EXPECT_THROW(linalg::solve_in_place(singular, rhs, ws), std::runtime_error);
+    EXPECT_THROW(linalg::solve_with_workspace(A, rhs, ws), std::invalid_argument);
+
+    const size_t big = 300;
+    static_assert(300 > linalg::lu_block_size, "must take the blocked path");
+    Matrix<double> L(big, big);
+    for (size_t i = 0; i < big; ++i) {
+        for (size_t j = 0; j < big; ++j) L.at(i, j) = std::sin(static_cast<double>(i + 2 * j));
+        L.at(i, i) += static_cast<double>(big);
+    }
+    Vector<double> y(big);
+    linalg::set_num_threads(4);
+    for (int warm_up = 0; warm_up < 3; ++warm_up) {
+        for (size_t i = 0; i < big; ++i) y[i] = 1.0;
+        linalg::solve_with_workspace(L, y, ws);
+    }
+    for (size_t i = 0; i < big; ++i) y[i] = 1.0;
+    const size_t before = heap_allocations;
+    linalg::solve_with_workspace(L, y, ws);
+    const size_t allocations = heap_allocations - before;
+    linalg::set_num_threads(linalg::default_num_threads());
+    EXPECT_EQ(allocations, 0u);
+}
+
+/**
+ * TEST CASE: Reduced Row Echelon Form
+ * 
+ * Verifies:
+ * 1. A rank-deficient rectangular matrix reaches its (unique) RREF
+ * 2. A large full-rank matrix (parallel elimination path) reduces to I
+ * 
+ * Mathematical Background:
+ * [1 2 1 4]          [1 2 0 3]
+ * [2 4 0 6]  RREF => [0 0 1 1]
+ * [1 2 2 5]          [0 0 0 0]
+ */
+TEST_F(MatrixTest, ReducedRowEchelonForm) {
+    Matrix<double> A(3, 4);
+    const double values[3][4] = {{1, 2, 1, 4}, {2, 4, 0, 6}, {1, 2, 2, 5}};
+    const double expected[3][4] = {{1, 2, 0, 3}, {0, 0, 1, 1}, {0, 0, 0, 0}};
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            A.at(i, j) = values[i][j];
+
+    Matrix<double> R = A.reduced_row_echelon_form();
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            EXPECT_NEAR(R.at(i, j), expected[i][j], 1e-12) << "Entry (" << i << ", " << j << ")";
+
+    const size_t n = 260;
+    Matrix<double> B(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) B.at(i, j) = std::sin(static_cast<double>(i + 3 * j));
+        B.at(i, i) += 10.0;
+    }
+    linalg::set_num_threads(4);
+    Matrix<double> I = B.reduced_row_echelon_form();
+    linalg::set_num_threads(linalg::default_num_threads());
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            EXPECT_NEAR(I.at(i, j), i == j ? 1.0 : 0.0, 1e-10);
+}
+
+/**
+ * TEST CASE: Cholesky Factorization
+ * 
+ * Verifies:
+ * 1. A small SPD system and its factor L (upper part zeroed)
+ * 2. The blocked, multithreaded path on a 300x300 SPD matrix
+ * 3. Rejection of a matrix that is not positive definite
+ * 
+ * Mathematical Background:
+ * [4 2]   [2 0] [2 1]
+ * [2 5] = [1 2]·[0 2]
+ */
+TEST_F(MatrixTest, CholeskyFactorization) {
+    Matrix<double> A(2, 2);
+    A.at(0, 0) = 4; A.at(0, 1) = 2;
+    A.at(1, 0) = 2; A.at(1, 1) = 5;
+    linalg::Cholesky<double> chol(A);
+    EXPECT_NEAR(chol.factor().at(0, 0), 2.0, 1e-12);
+    EXPECT_NEAR(chol.factor().at(1, 0), 1.0, 1e-12);
+    EXPECT_NEAR(chol.factor().at(1, 1), 2.0, 1e-12);
+    EXPECT_EQ(chol.factor().at(0, 1), 0.0) << "Upper triangle of L must be zero";
+    EXPECT_NEAR(chol.determinant(), 16.0, 1e-12);
+
+    // SPD test matrix: A(i,j) = 1 / (1 + |i - j|) plus a dominant diagonal
+    const size_t n = 300;
+    Matrix<double> S(n, n);
+    Vector<double> x_true(n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const double distance = static_cast<double>(i > j ? i - j : j - i);
+            S.at(i, j) = 1.0 / (1.0 + distance);
+        }
+        S.at(i, i) += 4.0;
+        x_true.at(i) = std::sin(static_cast<double>(i));
+    }
+    Vector<double> b(n);
+    for (size_t i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (size_t j = 0; j < n; ++j) sum += S.at(i, j) * x_true.at(j);
+        b.at(i) = sum;
+    }
+    for (size_t threads : {1u, 4u}) {
+        linalg::set_num_threads(threads);
+        Vector<double> x = linalg::solve_spd_system(S, b);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(x.at(i), x_true.at(i), 1e-10) << "threads = " << threads << ", i = " << i;
+        }
+    }
+    linalg::set_num_threads(linalg::default_num_threads());
+
+    Matrix<double> indefinite(2, 2);
+    indefinite.at(0, 0) = 1; indefinite.at(0, 1) = 3;
+    indefinite.at(1, 0) = 3; indefinite.at(1, 1) = 1;
+    EXPECT_THROW(linalg::Cholesky<double>{indefinite}, std::runtime_error);
+}
+
+/**
+ * TEST CASE: LDLᵀ Factorization of Indefinite Matrices
+ * 
+ * Verifies:
+ * 1. [0 1; 1 0] (zero diagonal, needs a 2x2 pivot block)
+ * 2. A 60x60 symmetric indefinite matrix mixing 1x1 and 2x2 pivots
+ */
+TEST_F(MatrixTest, LDLTFactorization) {
+    Matrix<double> swap(2, 2);
+    swap.at(0, 1) = 1; swap.at(1, 0) = 1;
+    Vector<double> b(2);
+    b.at(0) = 3; b.at(1) = 5;
+    Vector<double> x = linalg::solve_symmetric_system(swap, b);
+    EXPECT_NEAR(x.at(0), 5.0, 1e-12);
+    EXPECT_NEAR(x.at(1), 3.0, 1e-12);
+
+    const size_t n = 60;
+    Matrix<double> A(n, n);
+    unsigned state = 777u;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j <= i; ++j) {
+            state = state * 1664525u + 1013904223u;
+            const double value = static_cast<double>(state >> 8) / 16777216.0 - 0.5;
+            A.at(i, j) = value;
+            A.at(j, i) = value;
+        }
+        if (i % 3 == 0) A.at(i, i) = 0.0;  // force small diagonal pivots
+    }
+    Vector<double> x_true(n), rhs(n);
+    for (size_t i = 0; i < n; ++i) x_true.at(i) = static_cast<double>(i % 5) - 2.0;
+    for (size_t i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (size_t j = 0; j < n; ++j) sum += A.at(i, j) * x_true.at(j);
+        rhs.at(i) = sum;
+    }
+    Vector<double> y = linalg::LDLT<double>(A).solve(rhs);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(y.at(i), x_true.at(i), 1e-8) << "Component " << i;
+    }
+}
+
+/**
+ * TEST CASE: Assignment and Allocation Reuse
+ * 
+ * Verifies:
+ * 1. Copy and move assignment produce the expected contents
+ * 2. assign_product keeps C's buffer once it has the right shape
+ * 3. Shrinking resize keeps the buffer, growing beyond capacity reallocates
+ * 4. assign_product with C aliasing an operand gives the correct product
+ */
+TEST_F(MatrixTest, MatrixAssignment) {
+    Matrix<double> A(3, 3), B(3, 3), C(3, 3);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            A.at(i, j) = static_cast<double>(i * 3 + j);
+            B.at(i, j) = i == j ? 2.0 : 0.0;
+        }
+    }
+
+    C = A;
+    EXPECT_DOUBLE_EQ(C.at(2, 1), 7.0);
+    Matrix<double> D(1, 1);
+    D = std::move(C);
+    EXPECT_EQ(D.get_rows(), 3u);
+    EXPECT_DOUBLE_EQ(D.at(1, 2), 5.0);
+
+    Matrix<double> P(2, 5);
+    const double* buffer = P.data();
+    for (int iteration = 0; iteration < 3; ++iteration) {
+        linalg::assign_product(P, A, B);
+        EXPECT_EQ(P.data(), buffer);  // 3x3 fits in the 2x5 allocation
+    }
+    EXPECT_EQ(P.get_rows(), 3u);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_DOUBLE_EQ(P.at(i, j), 2.0 * A.at(i, j));
+        }
+    }
+
+    P.resize(1, 4);
+    EXPECT_EQ(P.data(), buffer);
+    EXPECT_EQ(P.capacity(), 10u);
+    P.resize(4, 4);
+    EXPECT_EQ(P.capacity(), 16u);
+    EXPECT_THROW(P.resize(0, 4), std::invalid_argument);
+
+    Matrix<double> wide(2, 4);
+    EXPECT_THROW(linalg::assign_product(P, A, wide), std::invalid_argument);
+
+    linalg::assign_product(A, A, B);  // A := A·B with A as an operand
+    EXPECT_DOUBLE_EQ(A.at(2, 2), 16.0);
+    EXPECT_DOUBLE_EQ(A.at(0, 1), 2.0);
+}
+
+/**
+ * TEST CASE: Construction Without Zero-Filling
+ * 
+ * Verifies:
+ * 1. The tagged constructor has the requested shape and accepts writes
+ * 2. Zero dimensions are still rejected
+ * 3. Results built on it (products, copies, expressions) are fully written
+ * 4. gemm with beta == 0 never reads C: NaN garbage in the output does not
+ *    leak into the product, across edge tiles and several k panels
+ */
+TEST_F(MatrixTest, UninitializedConstruction) {
+    Matrix<double> M(3, 4, linalg::uninitialized);
+    EXPECT_EQ(M.get_rows(), 3u);
+    EXPECT_EQ(M.get_cols(), 4u);
+    for (size_t i = 0; i < 12; ++i) M.data()[i] = static_cast<double>(i);
+    EXPECT_DOUBLE_EQ(M.at(2, 3), 11.0);
+    EXPECT_THROW((Matrix<double>(0, 4, linalg::uninitialized)), std::invalid_argument);
+
+    Matrix<double> copy(M);
+    Matrix<double> sum = M + copy;
+    Matrix<double> ones(4, 2);
+    for (size_t i = 0; i < 4; ++i) ones.at(i, 0) = ones.at(i, 1) = 1.0;
+    Matrix<double> rowsums = M * ones;
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(copy.at(i, 1), M.at(i, 1));
+        EXPECT_DOUBLE_EQ(sum.at(i, 2), 2.0 * M.at(i, 2));
+        EXPECT_DOUBLE_EQ(rowsums.at(i, 0), 16.0 * i + 6.0);
+        EXPECT_DOUBLE_EQ(rowsums.at(i, 1), 16.0 * i + 6.0);
+    }
+
+    const size_t m = 13, n = 11, k = 300;
+    std::vector<double> a(m * k), b(k * n);
+    std::vector<double> c(m * n, std::numeric_limits<double>::quiet_NaN());
+    for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<double>(i % 5) - 2.0;
+    for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<double>(i % 3) * 0.5;
+    linalg::gemm(m, n, k, 1.0, a.data(), k, size_t(1), b.data(), n, size_t(1),
+                 0.0, c.data(), n, size_t(1));
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            double expected = 0.0;
+            for (size_t p = 0; p < k; ++p) expected += a[i * k + p] * b[p * n + j];
+            EXPECT_NEAR(c[i * n + j], expected, 1e-9) << "(" << i << ", " << j << ")";
+        }
+    }
+}
+
+/**
+ * TEST CASE: Storage Policies
+ * 
+ * Verifies:
+ * 1. The default policy gives 64-byte aligned storage
+ * 2. Page alignment, huge pages and NUMA placement yield zeroed, usable
+ *    buffers (placement is only a hint on single-node machines)
+ * 3. Copies and resizes keep the policy; bad alignments are rejected
+ * 4. set_storage_policy reaches threads that already read the old default
+ */
+TEST_F(MatrixTest, StoragePolicies) {
+    Matrix<double> plain(3, 5);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(plain.data()) % 64, 0u);
+
+    linalg::StoragePolicy paged;
+    paged.alignment = 4096;
+    Matrix<float> small(2, 3, paged);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small.data()) % 4096, 0u);
+
+    linalg::StoragePolicy shared;
+    shared.huge_pages = true;
+    shared.placement = linalg::numa_placement::interleave;
+    Matrix<double> big(600, 600, shared);  // 2.9 MB: huge pages, 2 MiB aligned
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big.data()) % (size_t(2) << 20), 0u);
+    for (size_t i = 0; i < 600; ++i) {
+        EXPECT_DOUBLE_EQ(big.at(i, (i * 7) % 600), 0.0);
+        big.at(i, i) = 2.0;
+    }
+    Matrix<double> mid(100, 100, shared);  // 80 KB: interleaved ordinary pages
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mid.data()) % 4096, 0u);
+    EXPECT_DOUBLE_EQ(mid.at(99, 99), 0.0);
+    Matrix<double> copy(big);
+    EXPECT_EQ(copy.storage_policy().placement, linalg::numa_placement::interleave);
+    Matrix<double> sum = big + copy;
+    EXPECT_DOUBLE_EQ(sum.at(599, 599), 4.0);
+    copy.resize(700, 700);
+    EXPECT_TRUE(copy.storage_policy().huge_pages);
+
+    linalg::StoragePolicy local;
+    local.placement = linalg::numa_placement::node_local;
+    Matrix<double> product(200, 200, linalg::uninitialized, local);
+    linalg::assign_product(product, big, big);
+    EXPECT_DOUBLE_EQ(product.at(10, 10), 4.0);
+    EXPECT_GE(linalg::numa_nodes(), 1u);
+
+    linalg::StoragePolicy odd;
+    odd.alignment = 48;
+    EXPECT_THROW((Matrix<double>(2, 2, odd)), std::invalid_argument);
+    EXPECT_THROW(linalg::set_storage_policy(odd), std::invalid_argument);
+
+    const linalg::StoragePolicy saved = linalg::default_storage_policy();
+    linalg::set_storage_policy(paged);
+    Matrix<double> default_paged(2, 2);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(default_paged.data()) % 4096, 0u);
+    EXPECT_EQ(default_paged.storage_policy().alignment, 4096u);
+    linalg::set_storage_policy(saved);
+    EXPECT_EQ(Matrix<double>(2, 2).storage_policy().alignment, saved.alignment);
+}
+
+/**
+ * TEST CASE: Scoped Arena Allocation
+ * 
+ * Verifies:
+ * 1. Matrices and vectors created inside a scope come from the arena
+ * 2. Ending the scope rewinds the arena; nested scopes restore the outer one
+ * 3. Requests that do not fit fall back to the heap
+ * 4. A solver step inside a scope gives the same result as outside
+ * 5. Objects created before a scope that grow inside it (resize through
+ *    assignment, Vector reassignment, KrylovWorkspace::prepare) keep valid
+ *    buffers after a later scope has reused the arena
+ * 6. Arena temporaries moved out of the scope (into a std::vector, or as a
+ *    function's return value) are copied to system memory and stay valid
+ */
+TEST_F(MatrixTest, ArenaAllocation) {
+    linalg::Arena arena(1 << 20);
+    Matrix<double> A(8, 8);
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t j = 0; j < 8; ++j) A.at(i, j) = (i == j ? 10.0 : 1.0 / (1.0 + i + j));
+    }
+    Matrix<double> B(8, 2);
+    for (size_t i = 0; i < 8; ++i) { B.at(i, 0) = 1.0; B.at(i, 1) = static_cast<double>(i); }
+    const Matrix<double> expected = linalg::solve_linear_system(A, B);
+
+    Matrix<double> result(8, 2);
+    {
+        linalg::ArenaScope scope(arena);
+        Matrix<double> product = A * A;
+        Vector<double> v(100);
+        const auto base = reinterpret_cast<std::uintptr_t>(product.data());
+        EXPECT_GT(arena.used(), 0u);
+        EXPECT_EQ(arena.live_allocations(), 2u);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.data()) % 64, 0u);
+        EXPECT_GT(reinterpret_cast<std::uintptr_t>(v.data()), base);
+
+        {
+            linalg::ArenaScope inner(arena);
+            const size_t used = arena.used();
+            Matrix<double> huge(1024, 1024);  // 8 MiB does not fit: heap
+            EXPECT_EQ(arena.used(), used);
+            Vector<double> w(64);
+            EXPECT_GT(arena.used(), used);
+        }
+        EXPECT_EQ(arena.live_allocations(), 2u);
+
+        result = linalg::solve_linear_system(A, B);  // result's buffer predates the scope
+    }
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(arena.live_allocations(), 0u);
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_DOUBLE_EQ(result.at(i, 0), expected.at(i, 0));
+        EXPECT_DOUBLE_EQ(result.at(i, 1), expected.at(i, 1));
+    }
+
+    Matrix<double> outside(4, 4);  // no scope: heap
+    EXPECT_EQ(arena.used(), 0u);
+
+    Matrix<double> grown(2, 2);
+    Vector<double> vgrown(20);
+    linalg::KrylovWorkspace<double> ws;
+    {
+        linalg::ArenaScope scope(arena);
+        grown = A * A;                   // 2x2 -> 8x8: reallocates
+        Vector<double> v100(100);
+        for (size_t i = 0; i < 100; ++i) v100[i] = static_cast<double>(i);
+        vgrown = std::move(v100);        // arena buffer: copied into a grown buffer
+        ws.prepare(50, 3);
+        ws.vectors[2][49] = 7.0;
+        EXPECT_EQ(arena.live_allocations(), 1u);  // only v100's own buffer
+    }
+    EXPECT_EQ(arena.live_allocations(), 0u);
+    const Matrix<double> squared = A * A;
+    {
+        linalg::ArenaScope scope(arena);
+        Matrix<double> scratch1(8, 8), scratch2(8, 8);
+        Vector<double> scratch3(200);
+        for (size_t i = 0; i < 64; ++i) scratch1.data()[i] = scratch2.data()[i] = 42.0;
+        for (size_t i = 0; i < 200; ++i) scratch3[i] = 42.0;
+    }
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t j = 0; j < 8; ++j) EXPECT_DOUBLE_EQ(grown.at(i, j), squared.at(i, j));
+    }
+    for (size_t i = 0; i < 100; ++i) EXPECT_DOUBLE_EQ(vgrown[i], static_cast<double>(i));
+    EXPECT_DOUBLE_EQ(ws.vectors[2][49], 7.0);
+
+    std::vector<Matrix<double>> matrices;
+    std::vector<Vector<double>> vectors;
+    auto scoped_square = [&arena](const Matrix<double>& M) {
+        linalg::ArenaScope scope(arena);
+        Matrix<double> t = M * M;
+        return Matrix<double>(std::move(t));
+    };
+    {
+        linalg::ArenaScope scope(arena);
+        matrices.push_back(A * A);
+        Vector<double> v(100);
+        for (size_t i = 0; i < 100; ++i) v[i] = static_cast<double>(i);
+        vectors.push_back(std::move(v));
+    }
+    const Matrix<double> returned = scoped_square(A);
+    EXPECT_EQ(arena.live_allocations(), 0u);
+    {
+        linalg::ArenaScope scope(arena);
+        Matrix<double> scratch1(8, 8), scratch2(8, 8);
+        Vector<double> scratch3(200);
+        for (size_t i = 0; i < 64; ++i) scratch1.data()[i] = scratch2.data()[i] = 42.0;
+        for (size_t i = 0; i < 200; ++i) scratch3[i] = 42.0;
+    }
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t j = 0; j < 8; ++j) {
+            EXPECT_DOUBLE_EQ(matrices[0].at(i, j), squared.at(i, j));
+            EXPECT_DOUBLE_EQ(returned.at(i, j), squared.at(i, j));
+        }
+    }
+    for (size_t i = 0; i < 100; ++i) EXPECT_DOUBLE_EQ(vectors[0][i], static_cast<double>(i));
+    EXPECT_THROW(linalg::Arena(0), std::invalid_argument);
+}
+
+/**
+ * TEST CASE: Strided Matrix and Vector Views
+ * 
+ * Verifies:
+ * 1. block, column and transpose share storage with the matrix (O(1), no copy)
+ * 2. Views work in expressions, and assign() writes through them
+ * 3. A = A.transpose() is correct although source and target overlap
+ * 4. gemm, gemv and dot accept transposed and strided views
+ * 5. Vector::transpose flips the orientation without copying
+ */
+TEST_F(MatrixTest, StridedViews) {
+    Matrix<double> A(3, 4);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 4; ++j) A.at(i, j) = static_cast<double>(10 * i + j);
+    }
+
+    auto At = A.transpose();
+    EXPECT_EQ(At.data(), A.data());
+    EXPECT_EQ(At.get_rows(), 4u);
+    EXPECT_DOUBLE_EQ(At(3, 1), 13.0);
+    auto inner = A.block(1, 1, 2, 2);
+    EXPECT_DOUBLE_EQ(inner(1, 0), 21.0);
+    EXPECT_THROW(A.block(2, 2, 2, 1), std::out_of_range);
+    auto c2 = A.column(2);
+    EXPECT_EQ(c2.stride(), 4u);
+    EXPECT_DOUBLE_EQ(c2[2], 22.0);
+
+    Matrix<double> B = A.transpose();
+    EXPECT_EQ(B.get_rows(), 4u);
+    EXPECT_DOUBLE_EQ(B.at(2, 1), 12.0);
+    Matrix<double> S = A.transpose() + 2.0 * B;
+    EXPECT_DOUBLE_EQ(S.at(3, 2), 69.0);
+
+    Matrix<double> ones(2, 2);
+    for (size_t i = 0; i < 4; ++i) ones.data()[i] = 1.0;
+    inner.assign(-ones);
+    EXPECT_DOUBLE_EQ(A.at(2, 2), -1.0);
+    EXPECT_DOUBLE_EQ(A.at(0, 0), 0.0);
+
+    Matrix<double> C = A;
+    C = C.transpose();  // non-square, reads C while it is resized
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = 0; j < 3; ++j) EXPECT_DOUBLE_EQ(C.at(i, j), A.at(j, i));
+    }
+    Matrix<double> Q(3, 3);
+    for (size_t i = 0; i < 9; ++i) Q.data()[i] = static_cast<double>(i);
+    Q += Q.transpose();  // symmetric part, times two
+    EXPECT_DOUBLE_EQ(Q.at(0, 2), 8.0);
+    EXPECT_DOUBLE_EQ(Q.at(2, 0), 8.0);
+
+    // C(4x4) = Aᵀ·A through the strided GEMM, against a naive loop
+    Matrix<double> G(4, 4);
+    linalg::gemm(1.0, A.transpose(), A.view(), 0.0, G.view());
+    for (size_t i = 0; i < 4; ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            double sum = 0.0;
+            for (size_t k = 0; k < 3; ++k) sum += A.at(k, i) * A.at(k, j);
+            EXPECT_DOUBLE_EQ(G.at(i, j), sum);
+        }
+    }
+
+    Vector<double> x(3), y(4);
+    x[0] = 1.0; x[1] = 2.0; x[2] = 3.0;
+    linalg::gemv(1.0, A.transpose(), x.view(), 0.0, y.view());  // y = Aᵀx
+    Vector<double> strided_y(4);
+    linalg::gemv(1.0, A.transpose(), A.column(0), 0.0, strided_y.view());
+    for (size_t j = 0; j < 4; ++j) {
+        EXPECT_DOUBLE_EQ(y[j], A.at(0, j) + 2.0 * A.at(1, j) + 3.0 * A.at(2, j));
+        EXPECT_DOUBLE_EQ(strided_y[j], linalg::dot(A.column(j), A.column(0)));
+    }
+    EXPECT_THROW(linalg::gemv(1.0, A.view(), x.view(), 0.0, y.view()), std::invalid_argument);
+
+    EXPECT_TRUE(x.is_column_vector());
+    auto xt = x.transpose();
+    EXPECT_EQ(xt.data(), x.data());
+    EXPECT_FALSE(xt.is_column_vector());
+    Vector<double> row_copy = x.transpose();
+    EXPECT_FALSE(row_copy.is_column_vector());
+    EXPECT_DOUBLE_EQ(row_copy[2], 3.0);
+
+    x = x.view().segment(1, 2);  // shrinks x while reading from it
+    EXPECT_EQ(x.size(), 2u);
+    EXPECT_DOUBLE_EQ(x[0], 2.0);
+    EXPECT_DOUBLE_EQ(x[1], 3.0);
+}
+
+/**
+ * TEST CASE: Blocked Transpose
+ * 
+ * Verifies:
+ * 1. Out-of-place transposes of sizes that are not tile multiples, for
+ *    float, double and int, including the parallel path
+ * 2. In-place square transposes with a leading dimension
+ * 3. In-place rectangular transposes by cycle following
+ */
+TEST_F(MatrixTest, BlockedTranspose) {
+    auto check = [](auto tag, size_t m, size_t n) {
+        using T = decltype(tag);
+        Matrix<T> A(m, n);
+        for (size_t i = 0; i < m * n; ++i) A.data()[i] = static_cast<T>(i % 1000);
+        Matrix<T> B = A.transpose();
+        ASSERT_EQ(B.get_rows(), n);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                ASSERT_EQ(B(j, i), A(i, j)) << m << "x" << n << " at " << i << "," << j;
+            }
+        }
+        Matrix<T> C = A;
+        C.transpose_in_place();
+        ASSERT_EQ(C.get_rows(), n);
+        for (size_t i = 0; i < m * n; ++i) ASSERT_EQ(C.data()[i], B.data()[i]) << m << "x" << n;
+    };
+    for (size_t m : {1, 3, 8, 33, 70}) {
+        for (size_t n : {1, 4, 31, 64, 97}) {
+            check(double(), m, n);
+            check(float(), m, n);
+            check(int(), m, n);
+        }
+    }
+    check(double(), 700, 515);  // above transpose_parallel_limit
+    check(float(), 600, 600);
+
+    // Square in place inside a larger buffer: only the n x n corner moves
+    const size_t n = 45, lda = 50;
+    std::vector<double> buffer(n * lda);
+    for (size_t i = 0; i < buffer.size(); ++i) buffer[i] = static_cast<double>(i);
+    const std::vector<double> original = buffer;
+    linalg::transpose_in_place(n, buffer.data(), lda);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < lda; ++j) {
+            const double expected = j < n ? original[j * lda + i] : original[i * lda + j];
+            ASSERT_EQ(buffer[i * lda + j], expected);
+        }
+    }
+}
+
+/**
+ * TEST CASE: Compressed Sparse Matrices
+ * 
+ * Verifies:
+ * 1. Construction from unsorted COO triplets with duplicates (summed)
+ * 2. Dense round trips and CSR <-> CSC conversion
+ * 3. SpMV, transposed SpMV and sparse-dense products in both formats,
+ *    including a size that runs on the thread pool
+ * 4. Lower and upper triangular solves
+ */
+TEST_F(MatrixTest, SparseMatrix) {
+    using linalg::SparseMatrix;
+    using linalg::sparse_format;
+    auto same = [](const Matrix<double>& a, const Matrix<double>& b) {
+        if (a.get_rows() != b.get_rows() || a.get_cols() != b.get_cols()) return false;
+        return std::equal(a.data(), a.data() + a.get_rows() * a.get_cols(), b.data());
+    };
+    std::vector<linalg::Triplet<double>> entries = {
+        {2, 2, 4.0}, {0, 3, 1.0}, {0, 0, 5.0}, {1, 1, 2.0}, {2, 0, 3.0}, {0, 0, 1.0}, {1, 3, 0.0}};
+    SparseMatrix<double> A(3, 4, entries);
+    EXPECT_EQ(A.nonzeros(), 6u);  // (0,0) summed, explicit zero kept
+    EXPECT_DOUBLE_EQ(A.at(0, 0), 6.0);
+    EXPECT_DOUBLE_EQ(A.at(2, 1), 0.0);
+    EXPECT_EQ(A.outer_offsets(), (std::vector<size_t>{0, 2, 4, 6}));
+    EXPECT_EQ(A.inner_indices(), (std::vector<size_t>{0, 3, 1, 3, 0, 2}));
+    EXPECT_THROW(SparseMatrix<double>(3, 3, entries), std::out_of_range);
+
+    const Matrix<double> D = A.to_dense();
+    const SparseMatrix<double> C = A.to_format(sparse_format::csc);
+    EXPECT_EQ(C.format(), sparse_format::csc);
+    EXPECT_EQ(C.inner_indices(), (std::vector<size_t>{0, 2, 1, 2, 0, 1}));
+    EXPECT_TRUE(same(C.to_dense(), D));
+    EXPECT_TRUE(same(SparseMatrix<double>(D, sparse_format::csc).to_dense(), D));
+    EXPECT_TRUE(same(A.transpose().to_dense(), Matrix<double>(D.transpose())));
+
+    // Random band matrix, large enough for the parallel paths
+    const size_t n = 20000;
+    std::vector<linalg::Triplet<double>> band;
+    unsigned state = 7u;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = (i < 3 ? 0 : i - 3); j < std::min(n, i + 4); ++j) {
+            state = state * 1664525u + 1013904223u;
+            band.push_back({i, j, i == j ? 10.0 : static_cast<double>(state >> 24) / 256.0 - 0.5});
+        }
+    }
+    Vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = std::sin(static_cast<double>(i));
+    for (sparse_format format : {sparse_format::csr, sparse_format::csc}) {
+        const SparseMatrix<double> S(n, n, band, format);
+        Vector<double> expected(n), expected_t(n);
+        for (const auto& t : band) {
+            expected[t.row] += t.value * x[t.col];
+            expected_t[t.col] += t.value * x[t.row];
+        }
+        const Vector<double> y = S * x;
+        Vector<double> yt(n);
+        linalg::spmv_transposed(1.0, S, x, 0.0, yt);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_NEAR(y[i], expected[i], 1e-12);
+            ASSERT_NEAR(yt[i], expected_t[i], 1e-12);
+        }
+
+        // S.solve_lower / solve_upper read only their triangle of S
+        std::vector<linalg::Triplet<double>> lower, upper;
+        for (const auto& t : band) (t.col <= t.row ? lower : upper).push_back(t);
+        for (size_t i = 0; i < n; ++i) upper.push_back({i, i, 10.0});
+        const Vector<double> z = S.solve_lower(SparseMatrix<double>(n, n, lower, format) * x);
+        const Vector<double> w = S.solve_upper(SparseMatrix<double>(n, n, upper, format) * x);
+        for (size_t i = 0; i < n; ++i) {
+            ASSERT_NEAR(z[i], x[i], 1e-10);
+            ASSERT_NEAR(w[i], x[i], 1e-10);
+        }
+    }
+
+    Matrix<double> B(4, 3);
+    for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 3; ++j) B(i, j) = static_cast<double>(i + 2 * j) - 1.5;
+    const Matrix<double> expected = D * B;
+    EXPECT_TRUE(same(A * B, expected));
+    EXPECT_TRUE(same(C * B, expected));
+    Matrix<double> wide(4, 300);
+    for (size_t i = 0; i < 4 * 300; ++i) wide.data()[i] = static_cast<double>(i % 17);
+    EXPECT_TRUE(same(C * wide, D * wide));
+
+    SparseMatrix<double> singular(2, 2, {{0, 0, 1.0}, {1, 0, 1.0}});
+    EXPECT_THROW(singular.solve_lower(Vector<double>(2)), std::runtime_error);
+}
+
+/**
+ * TEST CASE: Krylov Solvers and Preconditioners
+ * 
+ * Verifies:
+ * 1. CG on a 2D Laplacian, plain and with Jacobi / ILU(0), checked against
+ *    the true residual; ILU(0) needs fewer iterations
+ * 2. BiCGSTAB and GMRES on a nonsymmetric convection-diffusion matrix
+ * 3. Dense Matrix and matrix-free (functor) operators
+ * 4. A reused KrylovWorkspace keeps its buffers across solves
+ * 5. With a warmed-up workspace, solves whose SpMV / GEMV run on the thread
+ *    pool make no heap allocation on the calling thread
+ */
+TEST_F(MatrixTest, IterativeSolvers) {
+    using linalg::SparseMatrix;
+    const size_t grid = 40, n = grid * grid;
+    auto build = [&](double convection) {
+        std::vector<linalg::Triplet<double>> entries;
+        for (size_t r = 0; r < grid; ++r) {
+            for (size_t c = 0; c < grid; ++c) {
+                const size_t i = r * grid + c;
+                entries.push_back({i, i, 4.0 + convection});
+                if (r > 0) entries.push_back({i, i - grid, -1.0});
+                if (r + 1 < grid) entries.push_back({i, i + grid, -1.0});
+                if (c > 0) entries.push_back({i, i - 1, -1.0 - convection});
+                if (c + 1 < grid) entries.push_back({i, i + 1, -1.0});
+            }
+        }
+        return SparseMatrix<double>(n, n, entries);
+    };
+    Vector<double> b(n);
+    for (size_t i = 0; i < n; ++i) b[i] = std::cos(0.1 * static_cast<double>(i));
+    auto relative_residual = [&](const SparseMatrix<double>& A, const Vector<double>& x) {
+        Vector<double> r = A * x;
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) sum += (b[i] - r[i]) * (b[i] - r[i]);
+        return std::sqrt(sum) / b.norm();
+    };
+
+    linalg::IterativeOptions<double> options;
+    options.tolerance = 1e-10;
+    const SparseMatrix<double> laplacian = build(0.0);
+    Vector<double> x(n);
+    const auto plain = linalg::conjugate_gradient(laplacian, b, x, options);
+    EXPECT_TRUE(plain.converged);
+    EXPECT_LT(relative_residual(laplacian, x), 1e-9);
+
+    x = Vector<double>(n);
+    const auto jacobi = linalg::conjugate_gradient(laplacian, b, x, options,
+                                                   linalg::JacobiPreconditioner<double>(laplacian));
+    EXPECT_TRUE(jacobi.converged);
+    EXPECT_LT(relative_residual(laplacian, x), 1e-9);
+
+    x = Vector<double>(n);
+    const linalg::ILU0Preconditioner<double> ilu(laplacian);
+    const auto incomplete = linalg::conjugate_gradient(laplacian, b, x, options, ilu);
+    EXPECT_TRUE(incomplete.converged);
+    EXPECT_LT(relative_residual(laplacian, x), 1e-9);
+    EXPECT_LT(incomplete.iterations, plain.iterations / 2);
+
+    // Nonsymmetric: upwinded convection term
+    const SparseMatrix<double> convection = build(0.8);
+    const linalg::ILU0Preconditioner<double> ilu_convection(convection);
+    linalg::KrylovWorkspace<double> ws;
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        x = Vector<double>(n);
+        const auto stab = linalg::bicgstab(convection, b, x, options, ilu_convection, &ws);
+        EXPECT_TRUE(stab.converged);
+        EXPECT_LT(relative_residual(convection, x), 1e-9);
+    }
+    const double* first = ws.vectors[0].data();
+    x = Vector<double>(n);
+    const auto restarted = linalg::bicgstab(convection, b, x, options, linalg::IdentityPreconditioner<double>(), &ws);
+    EXPECT_TRUE(restarted.converged);
+    EXPECT_EQ(ws.vectors[0].data(), first);
+
+    options.restart = 20;
+    for (bool preconditioned : {false, true}) {
+        x = Vector<double>(n);
+        const auto result = preconditioned
+            ? linalg::gmres(convection, b, x, options, ilu_convection, &ws)
+            : linalg::gmres(convection, b, x, options, linalg::IdentityPreconditioner<double>(), &ws);
+        EXPECT_TRUE(result.converged);
+        EXPECT_LT(relative_residual(convection, x), 1e-9);
+    }
+
+    // Dense operator and a matrix-free 1D Laplacian
+    const Matrix<double> dense = build(0.8).to_dense();
+    Vector<double> xd(n);
+    EXPECT_TRUE(linalg::gmres(dense, b, xd, options).converged);
+    EXPECT_LT(relative_residual(convection, xd), 1e-9);
+
+    auto stencil = [&](const Vector<double>& in, Vector<double>& out) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = 2.0 * in[i] - (i > 0 ? in[i - 1] : 0.0) - (i + 1 < n ? in[i + 1] : 0.0);
+        }
+    };
+    x = Vector<double>(n);
+    options.max_iterations = n;
+    EXPECT_TRUE(linalg::conjugate_gradient(stencil, b, x, options).converged);
+    Vector<double> check(n);
+    stencil(x, check);
+    for (size_t i = 0; i < n; ++i) ASSERT_NEAR(check[i], b[i], 1e-6);
+
+    // Large enough for the parallel SpMV and GEMV paths
+    const size_t big_grid = 100, big = big_grid * big_grid;
+    std::vector<linalg::Triplet<double>> entries;
+    for (size_t i = 0; i < big; ++i) {
+        entries.push_back({i, i, 4.0});
+        if (i >= big_grid) entries.push_back({i, i - big_grid, -1.0});
+        if (i + big_grid < big) entries.push_back({i, i + big_grid, -1.0});
+        if (i % big_grid > 0) entries.push_back({i, i - 1, -1.0});
+        if (i % big_grid + 1 < big_grid) entries.push_back({i, i + 1, -1.0});
+    }
+    const SparseMatrix<double> big_laplacian(big, big, entries);
+    ASSERT_GE(big_laplacian.nonzeros(), linalg::sparse_parallel_limit);
+    const linalg::JacobiPreconditioner<double> big_jacobi(big_laplacian);
+    Vector<double> big_b(big), big_x(big);
+    for (size_t i = 0; i < big; ++i) big_b[i] = std::sin(0.01 * static_cast<double>(i));
+    linalg::IterativeOptions<double> fixed;
+    fixed.tolerance = 0.0;
+    fixed.max_iterations = 40;
+    linalg::KrylovWorkspace<double> sparse_ws, dense_ws;
+    linalg::set_num_threads(4);
+    linalg::conjugate_gradient(big_laplacian, big_b, big_x, fixed, big_jacobi, &sparse_ws);
+    linalg::gmres(dense, b, xd, fixed, linalg::IdentityPreconditioner<double>(), &dense_ws);
+    size_t before = heap_allocations;
+    linalg::conjugate_gradient(big_laplacian, big_b, big_x, fixed, big_jacobi, &sparse_ws);
+    const size_t sparse_allocations = heap_allocations - before;
+    before = heap_allocations;
+    linalg::gmres(dense, b, xd, fixed, linalg::IdentityPreconditioner<double>(), &dense_ws);
+    const size_t dense_allocations = heap_allocations - before;
+    linalg::set_num_threads(linalg::default_num_threads());
+    EXPECT_EQ(sparse_allocations, 0u);
+    EXPECT_EQ(dense_allocations, 0u);
+
+    Vector<double> wrong(n + 1);
+    EXPECT_THROW(linalg::conjugate_gradient(laplacian, wrong, x), std::invalid_argument);
+    EXPECT_THROW(linalg::ILU0Preconditioner<double>(SparseMatrix<double>(2, 2, {{0, 1, 1.0}})),
+                 std::runtime_error);
+}
+
+/**
+ * TEST CASE: Banded Storage and Solvers
+ * 
+ * Verifies:
+ * 1. Band indexing, dense conversion and the band matrix-vector product
+ * 2. BandedLU with pivoting, BandedCholesky and the Thomas fast path
+ *    against the dense solver
+ * 3. Batched tridiagonal solves, including the parallel path
+ * 4. Errors for singular, indefinite and out-of-band cases
+ */
+TEST_F(MatrixTest, BandedSolvers) {
+    using linalg::BandedMatrix;
+    const size_t n = 300;
+    Vector<double> b(n);
+    for (size_t i = 0; i < n; ++i) b[i] = std::sin(0.3 * static_cast<double>(i)) + 1.0;
+    auto expect_solution = [&](const Matrix<double>& dense, const Vector<double>& x) {
+        const Vector<double> expected = linalg::solve_linear_system(dense, b);
+        for (size_t i = 0; i < n; ++i) ASSERT_NEAR(x[i], expected[i], 1e-9 * (1.0 + std::abs(expected[i])));
+    };
+
+    // General band, small diagonal so that pivoting is required
+    BandedMatrix<double> A(n, 2, 1);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = A.first_column(i); j <= A.last_column(i); ++j) {
+            A(i, j) = i == j ? 0.01 : std::cos(static_cast<double>(3 * i + j));
+        }
+    }
+    const Matrix<double> dense = A.to_dense();
+    EXPECT_DOUBLE_EQ(A.at(10, 8), dense(10, 8));
+    EXPECT_DOUBLE_EQ(A.at(10, 12), 0.0);
+    EXPECT_THROW(A.set(10, 12, 1.0), std::out_of_range);
+    EXPECT_THROW(A.at(n, 0), std::out_of_range);
+    const Vector<double> y = A * b;
+    const Vector<double> y_dense = dense * b;
+    for (size_t i = 0; i < n; ++i) ASSERT_NEAR(y[i], y_dense[i], 1e-12);
+
+    const linalg::BandedLU<double> lu(A);
+    expect_solution(dense, lu.solve(b));
+    expect_solution(dense, linalg::solve_banded_system(A, b));
+    EXPECT_TRUE(std::any_of(lu.pivot_indices().begin(), lu.pivot_indices().end(),
+                            [k = size_t(0)](size_t p) mutable { return p != k++; }));
+
+    // SPD band: Cholesky reads the lower band only
+    BandedMatrix<double> S(n, 3, 3);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = S.first_column(i); j <= S.last_column(i); ++j) {
+            S(i, j) = i == j ? 8.0 : -1.0 / static_cast<double>(1 + (i > j ? i - j : j - i));
+        }
+    }
+    expect_solution(S.to_dense(), linalg::BandedCholesky<double>(S).solve(b));
+    BandedMatrix<double> indefinite(S);
+    indefinite(5, 5) = -1.0;
+    EXPECT_THROW(linalg::BandedCholesky<double>{indefinite}, std::runtime_error);
+
+    // Tridiagonal: Thomas, also through solve_banded_system
+    BandedMatrix<double> D(n, 1, 1);
+    for (size_t i = 0; i < n; ++i) {
+        D(i, i) = 4.0;
+        if (i > 0) D(i, i - 1) = -1.0;
+        if (i + 1 < n) D(i, i + 1) = -1.5;
+    }
+    expect_solution(D.to_dense(), linalg::solve_tridiagonal(D, b));
+    expect_solution(D.to_dense(), linalg::solve_banded_system(D, b));
+    EXPECT_THROW(linalg::solve_tridiagonal(A, b), std::invalid_argument);
+    EXPECT_THROW(linalg::BandedLU<double>{BandedMatrix<double>(4, 1, 1)}, std::runtime_error);
+
+    // Batched: 3000 systems of size 17, one per row of the arrays
+    const size_t count = 3000, m = 17;
+    std::vector<double> lower(count * m), diag(count * m), upper(count * m), rhs(count * m);
+    for (size_t k = 0; k < count * m; ++k) {
+        lower[k] = -1.0 + 0.001 * static_cast<double>(k % 7);
+        upper[k] = -0.5;
+        diag[k] = 3.0 + static_cast<double>(k % m);
+        rhs[k] = std::cos(static_cast<double>(k));
+    }
+    std::vector<double> x(rhs);
+    linalg::solve_tridiagonal_batched(count, m, lower.data(), diag.data(), upper.data(), x.data());
+    for (size_t s = 0; s < count; s += 97) {
+        for (size_t i = 0; i < m; ++i) {
+            const size_t k = s * m + i;
+            double row = diag[k] * x[k];
+            if (i > 0) row += lower[k] * x[k - 1];
+            if (i + 1 < m) row += upper[k] * x[k + 1];
+            ASSERT_NEAR(row, rhs[k], 1e-12);
+        }
+    }
+    diag[5 * m] = 0.0;
+    EXPECT_THROW(linalg::solve_tridiagonal_batched(count, m, lower.data(), diag.data(), upper.data(), x.data()),
+                 std::runtime_error);
 }
 
 int main(int argc, char **argv) {